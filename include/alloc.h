@@ -0,0 +1,245 @@
+#ifndef ALLOC_H
+#define ALLOC_H
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// smallest block (in bytes) served by the pool, classes double from here.
+constexpr size_t POOL_MIN_BLOCK = 64U;
+// number of size classes, 64 bytes to 64 KiB.
+constexpr size_t POOL_CLASSES = 11U;
+// free blocks kept per size class, the rest go back to the heap.
+constexpr size_t POOL_MAX_CACHED = 64U;
+// size (in bytes) of the first scratch arena chunk.
+constexpr size_t ARENA_CHUNK = 1U << 16;
+// alignment of scratch arena allocations.
+constexpr size_t ARENA_ALIGN = alignof(std::max_align_t);
+
+/* =======================================================*
+ *                    SIZE CLASS POOL                     *
+   =======================================================*/
+
+/**
+ * @brief Check if the pool of this thread was destroyed (thread exit).
+ */
+inline bool &pool_destroyed() noexcept
+{
+    static thread_local bool destroyed = false;
+    return destroyed;
+}
+
+/**
+ * @brief Per-thread free lists of power of two sized blocks.
+ * Blocks are plain heap allocations, so a block freed on
+ * another thread simply joins that thread's free list.
+ */
+class block_pool
+{
+    struct node
+    {
+        node *next;
+    };
+    node *heads[POOL_CLASSES] = {};
+    size_t counts[POOL_CLASSES] = {};
+
+    static size_t size_class(const size_t bytes) noexcept
+    {
+        size_t c = 0;
+        for (size_t size = POOL_MIN_BLOCK; size < bytes; size <<= 1)
+            ++c;
+        return c;
+    }
+
+public:
+    block_pool() noexcept = default;
+    block_pool(const block_pool &) = delete;
+    block_pool &operator=(const block_pool &) = delete;
+
+    ~block_pool()
+    {
+        for (size_t c = 0; c < POOL_CLASSES; ++c)
+            while (heads[c])
+            {
+                node *block = heads[c];
+                heads[c] = block->next;
+                ::operator delete(block);
+            }
+        pool_destroyed() = true;
+    }
+
+    void *allocate(const size_t bytes)
+    {
+        const size_t c = size_class(bytes);
+        if (c >= POOL_CLASSES)
+            return ::operator new(bytes);
+        if (node *block = heads[c])
+        {
+            heads[c] = block->next;
+            --counts[c];
+            return block;
+        }
+        return ::operator new(POOL_MIN_BLOCK << c);
+    }
+
+    void deallocate(void *ptr, const size_t bytes) noexcept
+    {
+        const size_t c = size_class(bytes);
+        if (c >= POOL_CLASSES || counts[c] >= POOL_MAX_CACHED)
+            return ::operator delete(ptr);
+        node *block = static_cast<node *>(ptr);
+        block->next = heads[c];
+        heads[c] = block;
+        ++counts[c];
+    }
+};
+
+/**
+ * @brief Get the block pool of this thread.
+ */
+inline block_pool &get_pool() noexcept
+{
+    static thread_local block_pool pool;
+    return pool;
+}
+
+/**
+ * @brief Allocator serving blocks from the per-thread pool.
+ * Falls back to the heap once the pool of the thread is gone.
+ * @tparam T element type.
+ */
+template <typename T>
+struct pool_allocator
+{
+    typedef T value_type;
+
+    pool_allocator() noexcept = default;
+    template <typename U>
+    pool_allocator(const pool_allocator<U> &) noexcept {}
+
+    T *allocate(const size_t n)
+    {
+        if (pool_destroyed())
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        return static_cast<T *>(get_pool().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, const size_t n) noexcept
+    {
+        if (pool_destroyed())
+            return ::operator delete(ptr);
+        get_pool().deallocate(ptr, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+inline bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) noexcept
+{
+    return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) noexcept
+{
+    return false;
+}
+
+/* =======================================================*
+ *                     SCRATCH ARENA                      *
+   =======================================================*/
+
+/**
+ * @brief Per-thread stack of scratch memory for kernel temporaries.
+ * Memory is handed out by bumping an offset and given back in
+ * reverse order by scratch_scope, chunks are kept for reuse.
+ */
+class scratch_arena
+{
+    struct chunk
+    {
+        char *mem;
+        size_t size;
+    };
+    std::vector<chunk> chunks;
+    size_t current = 0;
+    size_t offset = 0;
+
+public:
+    struct mark
+    {
+        size_t chunk;
+        size_t offset;
+    };
+
+    scratch_arena() noexcept = default;
+    scratch_arena(const scratch_arena &) = delete;
+    scratch_arena &operator=(const scratch_arena &) = delete;
+
+    ~scratch_arena()
+    {
+        for (const chunk &c : chunks)
+            ::operator delete(c.mem);
+    }
+
+    mark top() const noexcept { return {current, offset}; }
+
+    void release(const mark &m) noexcept
+    {
+        current = m.chunk;
+        offset = m.offset;
+    }
+
+    void *allocate(size_t bytes)
+    {
+        bytes = (bytes + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+        for (; current < chunks.size(); ++current, offset = 0)
+            if (chunks[current].size - offset >= bytes)
+            {
+                void *ptr = chunks[current].mem + offset;
+                offset += bytes;
+                return ptr;
+            }
+        const size_t size = std::max(bytes, chunks.empty() ? ARENA_CHUNK
+                                                           : 2 * chunks.back().size);
+        chunks.push_back({static_cast<char *>(::operator new(size)), size});
+        current = chunks.size() - 1;
+        offset = bytes;
+        return chunks.back().mem;
+    }
+};
+
+/**
+ * @brief Get the scratch arena of this thread.
+ */
+inline scratch_arena &get_arena() noexcept
+{
+    static thread_local scratch_arena arena;
+    return arena;
+}
+
+/**
+ * @brief Scoped scratch allocations, released together on scope exit.
+ * Scopes nest, so recursive kernels get stack-like temporaries.
+ */
+class scratch_scope
+{
+    scratch_arena &arena;
+    const scratch_arena::mark mark;
+
+public:
+    scratch_scope() noexcept : arena(get_arena()), mark(arena.top()) {}
+    scratch_scope(const scratch_scope &) = delete;
+    scratch_scope &operator=(const scratch_scope &) = delete;
+    ~scratch_scope() { arena.release(mark); }
+
+    /**
+     * @brief Allocate uninitialized scratch for size elements.
+     */
+    template <typename T>
+    T *alloc(const size_t size)
+    {
+        return static_cast<T *>(arena.allocate(size * sizeof(T)));
+    }
+};
+
+#endif // ALLOC_H
@@ -0,0 +1,74 @@
+#ifndef CONTEXT_H
+#define CONTEXT_H
+#include <iostream>
+#include <cstdint>
+
+// fraction length limit that keeps every digit.
+constexpr size_t UNBOUNDED = SIZE_MAX;
+
+/**
+ * @brief Rounding applied when fraction digits are discarded.
+ */
+enum rounding
+{
+    ROUND_HALF_EVEN, // to nearest, ties to even digit
+    ROUND_DOWN,      // towards zero
+    ROUND_UP,        // away from zero
+    ROUND_CEILING,   // towards positive infinity
+    ROUND_FLOOR      // towards negative infinity
+};
+
+/**
+ * @brief Arithmetic settings shared by the operations of a thread.
+ */
+struct context
+{
+    // fraction digits produced by inexact division.
+    size_t precision = 20U;
+    // fraction digits kept by multiplication, addition and division.
+    size_t max_fraction = UNBOUNDED;
+    // rounding of the discarded digits.
+    rounding mode = ROUND_UP;
+};
+
+/**
+ * @brief Get the arithmetic context of the current thread.
+ * @return reference to the thread's context.
+ */
+inline context &getcontext() noexcept
+{
+    static thread_local context ctx;
+    return ctx;
+}
+
+/**
+ * @brief Decide if a truncated magnitude is rounded away from zero.
+ * @param mode rounding mode.
+ * @param sign sign of the number.
+ * @param inexact whether non zero digits were discarded.
+ * @param half discarded part compared with half a unit (-1, 0, 1).
+ * @param odd whether the last kept digit is odd.
+ * @return true if the magnitude is incremented by one unit.
+ */
+inline bool round_away(const rounding mode, const bool sign, const bool inexact,
+                       const short half, const bool odd) noexcept
+{
+    if (!inexact)
+        return false;
+    switch (mode)
+    {
+    case ROUND_HALF_EVEN:
+        return half > 0 || (half == 0 && odd);
+    case ROUND_DOWN:
+        return false;
+    case ROUND_UP:
+        return true;
+    case ROUND_CEILING:
+        return !sign;
+    case ROUND_FLOOR:
+        return sign;
+    }
+    return false;
+}
+
+#endif // CONTEXT_H
@@ -0,0 +1,104 @@
+#ifndef DIVISOR_H
+#define DIVISOR_H
+#include <stdexcept>
+#include "mnum.h"
+
+/**
+ * @brief Divisor prepared once for repeated division.
+ * The barrett reciprocal of the divisor limbs is computed up front,
+ * so each division only scales the dividend to the fraction digits
+ * of the divisor and multiplies by the reciprocal.
+ * Dividends with more fraction digits than the divisor fall back
+ * to the regular mnum operations.
+ */
+class divisor
+{
+    mnum y;
+    limb_vector m;  // divisor * 10^frac
+    limb_vector mu; // barrett reciprocal of m
+    size_t frac;    // fraction digits of the divisor
+
+    // scale x to x * 10^frac, false if x has more fraction digits
+    bool scale(const mnum &x, limb_vector &xl) const
+    {
+        if (x.frac > this->frac)
+            return false;
+        xl = x.mag;
+        lmul_pow10(xl, this->frac - x.frac);
+        return true;
+    }
+
+    // floor remainder of scaled limbs, takes the divisor sign
+    mnum floor_rem(limb_vector &rem, const bool xsign) const
+    {
+        const bool sign = !rem.empty() && this->y.sign;
+        if (!rem.empty() && xsign != this->y.sign)
+        { // rem = m - rem, nonzero as rem < m
+            limb_vector comp(this->m);
+            lisub(comp, rem);
+            rem.swap(comp);
+        }
+        const context &ctx = getcontext();
+        size_t frac = this->frac;
+        strip_fraction(rem, frac);
+        fround(rem, frac, ctx.max_fraction, sign, ctx.mode);
+        return mnum(std::move(rem), frac, sign);
+    }
+
+public:
+    /**
+     * @brief Prepare a divisor.
+     * @param y divisor.
+     * @throw std::domain_error if y is zero.
+     */
+    explicit divisor(const mnum &y) : y(y)
+    {
+        this->m = y.mag;
+        this->frac = y.frac;
+        if (this->m.empty())
+            throw std::domain_error("division by zero");
+        this->mu = barrett_reciprocal(this->m);
+    }
+
+    const mnum &value() const noexcept
+    {
+        return this->y;
+    }
+
+    // integer quotient truncated towards zero, as mnum::div
+    mnum div(const mnum &x) const
+    {
+        limb_vector xl;
+        if (!this->scale(x, xl))
+            return x.div(this->y);
+        const limb_vector quot = barrett_ldivmod(xl, this->m, this->mu).first;
+        return mnum(quot, 0, x.sign ^ this->y.sign);
+    }
+
+    // remainder of floor division, as mnum::operator%
+    mnum mod(const mnum &x) const
+    {
+        limb_vector xl;
+        if (!this->scale(x, xl))
+            return x % this->y;
+        limb_vector rem = barrett_ldivmod(xl, this->m, this->mu).second;
+        return this->floor_rem(rem, x.sign);
+    }
+
+    // floor quotient and remainder, as mnum::floor_div and mnum::operator%
+    std::pair<mnum, mnum> divmod(const mnum &x) const
+    {
+        limb_vector xl;
+        if (!this->scale(x, xl))
+            return {x.floor_div(this->y), x % this->y};
+        std::pair<limb_vector, limb_vector> div =
+            barrett_ldivmod(xl, this->m, this->mu);
+        const bool sign = x.sign != this->y.sign;
+        if (sign && !div.second.empty()) // round towards negative infinity
+            liadd(div.first, {1});
+        mnum quot(std::move(div.first), 0, sign);
+        return {std::move(quot), this->floor_rem(div.second, x.sign)};
+    }
+};
+
+#endif // DIVISOR_H
@@ -3,285 +3,338 @@
 #include <iostream>
 #include <vector>
 #include <cassert>
+#include <cmath>
 #include "utils.h"
 #include "imath.h"
 
+/*
+ * Fixed point operations on numbers held as base 10^9 limbs x of the
+ * magnitude * 10^fx, fx being the number of fraction digits.
+ */
+
+/**
+ * @brief Remove trailing zeros of the fraction.
+ * @param x magnitude * 10^fx.
+ * @param fx number of fraction digits.
+ * @param * vector of limbs.
+ */
+void strip_fraction(limb_vector &x, size_t &fx)
+{
+    if (x.empty())
+    { // zero has no fraction
+        fx = 0;
+        return;
+    }
+    const size_t zeros = std::min(lzeros(x), fx);
+    ltruncate(x, zeros);
+    fx -= zeros;
+}
+
 /**
- * @brief Perform inplace float addition.
- * @param x augend integer part.
- * @param fx augend fraction part.
- * @param y addend integer part.
- * @param fy addend fraction part.
- * @param * vectors of intergers 0-9.
+ * @brief Drop a single zero fraction digit, it reads as no fraction.
+ * @param x magnitude * 10^fx.
+ * @param fx number of fraction digits.
+ * @param * vector of limbs.
  */
-void iadd(std::vector<udigit> &x, std::vector<udigit> &fx,
-          const std::vector<udigit> &y, const std::vector<udigit> &fy)
+inline void normalize_fraction(limb_vector &x, size_t &fx)
 {
-    /* perform float addition */
-    const size_t fx_size = fx.size(), fy_size = fy.size();
-    const size_t fmax_size = std::max(fx_size, fy_size);
-    if (fx_size < fy_size)
-        fx.resize(fy_size);
-
-    auto fxi = fx.rbegin();
-    udigit nx, ny, res, carry = 0;
-    for (int64_t i = fmax_size - 1; i > -1; --i, ++fxi)
+    if (fx == 1 && ldigit(x, 0) == 0)
     {
-        const size_t idx = static_cast<size_t>(i);
-        ny = fy_size > idx ? fy[idx] : 0;
-        res = *fxi + ny + carry;
-        carry = (res < 10) ? 0 : (res -= 10, 1);
-        fx[idx] = res;
+        ltruncate(x, 1);
+        fx = 0;
     }
-    /* perform integer addition */
-    const size_t x_size = x.size(), y_size = y.size();
-    const size_t max_size = std::max(x_size, y_size);
-    if (x_size < y_size)
-        x.resize(y_size);
+}
 
-    auto xi = x.rbegin();
-    auto yi = y.rbegin();
+/**
+ * @brief Scale two numbers to integers with a common fraction.
+ * @param x first magnitude * 10^fx.
+ * @param fx fraction digits of x.
+ * @param y second magnitude * 10^fy.
+ * @param fy fraction digits of y.
+ * @param xs receives x * 10^(f - fx), f = max(fx, fy).
+ * @param ys receives y * 10^(f - fy).
+ * @param * vectors of limbs.
+ */
+inline void common_scale(const limb_vector &x, const size_t fx,
+                         const limb_vector &y, const size_t fy,
+                         limb_vector &xs, limb_vector &ys)
+{
+    xs = x, ys = y;
+    if (fx < fy)
+        lmul_pow10(xs, fy - fx);
+    else
+        lmul_pow10(ys, fx - fy);
+}
 
-    // skip zeros caused from resizing.
-    if (x_size < y_size)
-        xi += y_size - x_size;
+/**
+ * @brief Truncate the fraction to its leading digits.
+ * @param x magnitude * 10^fx.
+ * @param fx number of fraction digits.
+ * @param keep leading fraction digits to keep (at most fx).
+ * @param * vector of limbs.
+ * @return x * 10^(keep - fx) truncated towards zero.
+ */
+limb_vector truncate_fraction(const limb_vector &x, const size_t fx,
+                              const size_t keep)
+{
+    limb_vector result(x);
+    ltruncate(result, fx - keep);
+    return result;
+}
 
-    for (int64_t i = max_size - 1; i > -1; --i)
-    {
-        nx = xi != x.rend() ? *xi++ : 0;
-        ny = yi != y.rend() ? *yi++ : 0;
-        res = nx + ny + carry;
-        carry = (res < 10) ? 0 : (res -= 10, 1);
-        x[i] = res;
-    }
-    if (!carry)
-        return;
-    x.insert(x.begin(), carry);
+/**
+ * Compare fixed point magnitudes
+ *
+ * @param x first magnitude * 10^fx.
+ * @param fx fraction digits of x.
+ * @param y second magnitude * 10^fy.
+ * @param fy fraction digits of y.
+ * @return 0 if equal, -1 if lesser, 1 if greater.
+ */
+short cmp(const limb_vector &x, const size_t fx,
+          const limb_vector &y, const size_t fy)
+{
+    if (fx == fy || x.empty() || y.empty())
+        return lcmp(x, y);
+    // integer digits decide unless they are equal
+    const long x_exp = static_cast<long>(ldigits(x)) - static_cast<long>(fx);
+    const long y_exp = static_cast<long>(ldigits(y)) - static_cast<long>(fy);
+    if (x_exp != y_exp)
+        return x_exp > y_exp ? 1 : -1;
+    limb_vector xs, ys;
+    common_scale(x, fx, y, fy, xs, ys);
+    return lcmp(xs, ys);
 }
 
 /**
- * @brief Perform inplace float subtraction.
- * @param x minuend integer part.
- * @param fx minuend fraction part.
- * @param y subtrahend integer part.
- * @param fy subtrahend fraction part.
- * @param * vectors of intergers 0-9.
+ * @brief Round the fraction to a number of digits.
+ * @param x magnitude * 10^fx.
+ * @param fx number of fraction digits.
+ * @param digits fraction digits to keep.
+ * @param sign sign of the number.
+ * @param mode rounding of the discarded digits.
+ * @param * vector of limbs.
  */
-void isub(std::vector<udigit> &x, std::vector<udigit> &fx,
-          const std::vector<udigit> &y, const std::vector<udigit> &fy,
-          const short &icmp, const short &comp)
+void fround(limb_vector &x, size_t &fx,
+            const size_t digits, const bool sign, const rounding mode)
 {
-    if (icmp == 0)
-    { // set x => 0 if x == y
-        x.assign(1, 0);
-        if (comp == 0)
-        { // set fx => 0 if fx == fy
-            fx.assign(1, 0);
-            return;
-        }
-    }
-    const bool rev_sub = comp == -1;
-
-    /* perform float subtraction */
-    std::vector<udigit> *px = &fx, *py;
-    py = const_cast<std::vector<udigit> *>(&fy);
-    size_t x_size = fx.size(), y_size = fy.size();
-    size_t max_size = std::max(x_size, y_size);
-    if (x_size < y_size)
-        fx.resize(y_size);
-    if (rev_sub)
-    {
-        std::swap(px, py);
-        std::swap(x_size, y_size);
-    }
-    int_fast8_t res;
-    udigit nx, ny, borrow = 0;
-    for (int64_t i = max_size - 1; i > -1; --i)
-    {
-        const size_t idx = static_cast<size_t>(i);
-        nx = x_size > idx ? (*px)[idx] : 0;
-        ny = y_size > idx ? (*py)[idx] : 0;
-        res = nx - ny - borrow;
-        borrow = res >= 0 ? 0 : 1;
-        res = borrow ? res + 10 : res;
-        fx[idx] = res;
-    }
-    if (icmp == 0) // x == y
-    {
-        assert(borrow == 0 &&
-               "invalid integer subtraction");
+    if (fx <= digits)
         return;
-    }
-    /* perform integer subtraction */
-    px = &x, py = const_cast<std::vector<udigit> *>(&y);
-    x_size = x.size(), y_size = y.size();
-    max_size = std::max(x_size, y_size);
-    if (x_size < y_size)
-        x.resize(y_size);
-    if (rev_sub)
-        std::swap(px, py);
-
-    auto xi = px->rbegin();
-    auto yi = py->rbegin();
-    // skip zeros caused from resizing.
-    if (x_size < y_size)
-        (rev_sub ? yi : xi) += y_size - x_size;
-
-    for (int64_t i = max_size - 1; i > -1; --i)
-    {
-        nx = xi != px->rend() ? *xi++ : 0;
-        ny = yi != py->rend() ? *yi++ : 0;
-        res = nx - ny - borrow;
-        borrow = res >= 0 ? 0 : 1;
-        res = borrow ? res + 10 : res;
-        x[i] = res;
-    }
-    lstrip_zeros(x);
-    assert(borrow == 0 && "invalid float subtraction");
+    lround(x, fx - digits, mode, sign);
+    fx = digits;
+    strip_fraction(x, fx);
 }
 
 /**
  * @brief Perform inplace float multiplication.
- * @param x multiplicand integer part.
- * @param fx multiplicand fraction part.
- * @param y multiplier integer part.
- * @param fy multiplier fraction part.
- * @param * vectors of intergers 0-9.
+ * @param x multiplicand magnitude * 10^fx.
+ * @param fx fraction digits of the multiplicand.
+ * @param y multiplier magnitude * 10^fy.
+ * @param fy fraction digits of the multiplier.
+ * @param sign sign of the product.
+ * @param max_fraction maximum fraction digits of the product.
+ * @param mode rounding of the discarded digits.
+ * @param * vectors of limbs.
+ * @attention fraction digits that can't reach the rounded product are
+ * truncated off the operands first, the full product is only formed
+ * when the guard digits leave the rounding direction undecided.
  */
-void imul(std::vector<udigit> &x, std::vector<udigit> &fx,
-          const std::vector<udigit> &y, const std::vector<udigit> &fy)
+void imul(limb_vector &x, size_t &fx,
+          const limb_vector &y, const size_t fy,
+          const bool sign = false,
+          const size_t max_fraction = getcontext().max_fraction,
+          const rounding mode = getcontext().mode)
 {
-    const size_t fx_size = fx.size();
-    const size_t fy_size = fy.size();
-    if ((fx_size == 1 && fx[0] == 0) &&
-        (fy_size == 1 && fy[0] == 0))
+    // operands may alias, check before x is modified
+    const bool square = &x == &y || (fx == fy && x == y);
+    if (fx == 0 && fy == 0)
     { // if fractions are zero
-        std::vector<udigit>
-            res = mul(x, y);
-        x.swap(res);
+#ifdef __SIZEOF_INT128__
+        if (fits_machine(x, fx) && fits_machine(y, fy))
+        { // native product of machine words
+            from_machine(static_cast<unsigned __int128>(to_machine(x)) * to_machine(y), x);
+            return;
+        }
+#else
+        if (x.size() + y.size() <= MACHINE_DIGITS / LIMB_DIGITS)
+        { // native product of machine words
+            from_machine(to_machine(x) * to_machine(y), x);
+            return;
+        }
+#endif
+        x = square ? lsqr(x) : lmul(x, y);
         return;
     }
-    if ((x[0] == 0 && (fx_size == 1 && fx[0] == 0)) ||
-        (y[0] == 0 && (fy_size == 1 && fy[0] == 0)))
+    if (x.empty() || y.empty())
     { // if multiplied by zero
-        x.assign(1, 0);
-        fx.assign(1, 0);
+        x.clear();
+        fx = 0;
         return;
     }
-    std::vector<udigit> xfx;
-    xfx.reserve(x.size() + fx_size);
-    xfx = std::move(x);
-    std::move(fx.begin(), fx.end(), std::back_inserter(xfx));
-
-    std::vector<udigit> yfy;
-    yfy.reserve(y.size() + fy_size);
-    yfy.assign(y.begin(), y.end());
-    yfy.insert(yfy.end(), fy.begin(), fy.end());
-
-    std::vector<udigit> result(xfx.size() + yfy.size(), 0);
-    for (auto xi = xfx.rbegin(); xi != xfx.rend(); ++xi)
-    {
-        udigit carry = 0;
-        auto res_it = result.rbegin() + (xi - xfx.rbegin());
-        for (auto yi = yfy.rbegin(); yi != yfy.rend(); ++yi, ++res_it)
-        {
-            udigit prod = *xi * *yi + carry + *res_it;
-            carry = prod / 10;
-            *res_it = prod % 10;
+    size_t frac_size = fx + fy;
+    if (frac_size > max_fraction)
+    { // fraction digits each operand needs for a guard limb below the kept digits
+        const size_t guard = max_fraction + LIMB_DIGITS + 1;
+        const size_t x_size = ldigits(x), y_size = ldigits(y);
+        const size_t fx_keep = std::min(fx, guard + (y_size > fy ? y_size - fy : 0));
+        const size_t fy_keep = std::min(fy, guard + (x_size > fx ? x_size - fx : 0));
+        if (fx_keep + fy_keep < frac_size)
+        { // the truncated operands put the product within two guard units
+            const limb_vector lx = truncate_fraction(x, fx, fx_keep);
+            limb_vector result = square ? lsqr(lx) : lmul(lx, truncate_fraction(y, fy, fy_keep));
+            ltruncate(result, fx_keep + fy_keep - max_fraction - LIMB_DIGITS);
+            if (lround_guard(result, mode, sign))
+            {
+                x.swap(result);
+                fx = max_fraction;
+                strip_fraction(x, fx);
+                return;
+            }
         }
-        *res_it += carry;
     }
-    x.clear();  // clear previous values
-    fx.clear(); // clear previous values
-
-    const size_t dec_point = result.size() - (fx_size + fy_size);
-    x.reserve(dec_point ? dec_point : 1);
-    fx.reserve(result.size() - dec_point);
-
-    std::move(result.begin(), result.begin() + dec_point, std::back_inserter(x));
-    std::move(result.begin() + dec_point, result.end(), std::back_inserter(fx));
-    lstrip_zeros(x);  // remove trailing zeros (if any present in x if empty add 0)
-    rstrip_zeros(fx); // remove trailing zeros (if any present in fx if empty add 0)
+    limb_vector result = square ? lsqr(x) : lmul(x, y);
+    if (frac_size > max_fraction)
+    { // round the exact product
+        lround(result, frac_size - max_fraction, mode, sign);
+        frac_size = max_fraction;
+    }
+    x.swap(result);
+    fx = frac_size;
+    strip_fraction(x, fx);
 }
 
 /**
  * @brief Perform float division.
- * @param x dividend integer part.
- * @param fx dividend fraction part.
- * @param y divisor integer part.
- * @param fy divisor fraction part.
- * @param * vectors of intergers 0-9.
- * @return quotient integer part and remainder.
+ * @param x dividend magnitude * 10^fx.
+ * @param fx fraction digits of the dividend.
+ * @param y divisor magnitude * 10^fy.
+ * @param fy fraction digits of the divisor.
+ * @param * vectors of limbs.
+ * @return quotient integer part and remainder (scaled by the common fraction).
  * @throw std::domain_error if division by zero.
  */
-inline const std::pair<std::vector<udigit>, double> divmod(
-    const std::vector<udigit> &x, const std::vector<udigit> &fx,
-    const std::vector<udigit> &y, const std::vector<udigit> &fy)
+const std::pair<limb_vector, limb_vector> divmod(
+    const limb_vector &x, const size_t fx,
+    const limb_vector &y, const size_t fy)
 {
-    size_t fx_size = fx.size();
-    size_t fy_size = fy.size();
-    if (fx_size == 1 && (fx.front() == 0))
-        fx_size = 0;
-    if (fy_size == 1 && (fy.front() == 0))
-        fy_size = 0;
-
-    std::vector<udigit> xfx, yfy;
-    xfx.reserve(x.size() + fx_size);
-    yfy.reserve(y.size() + fy_size);
-    xfx.assign(x.begin(), x.end());
-    yfy.assign(y.begin(), y.end());
-
-    if (fx_size) // if fx doesn't only contain zero
-        xfx.insert(xfx.end(), fx.begin(), fx.end());
-    if (fy_size) // if fy doesn't only contain zero
-        yfy.insert(yfy.end(), fy.begin(), fy.end());
-
-    if (fx_size < fy_size) // normalize denominator
-        xfx.insert(xfx.end(), fy_size - fx_size, 0);
-    else if (fx_size > fy_size) // normalize nominator
-        yfy.insert(yfy.end(), fx_size - fy_size, 0);
-
-    return divmod(xfx, yfy); // perform division
+    limb_vector xs, ys;
+    common_scale(x, fx, y, fy, xs, ys);
+    if (fits_machine(xs, 0) && fits_machine(ys, 0) && !ys.empty())
+    { // native division of machine words
+        const uint64_t a = to_machine(xs), b = to_machine(ys);
+        std::pair<limb_vector, limb_vector> res;
+        from_machine(a / b, res.first);
+        from_machine(a % b, res.second);
+        return res;
+    }
+    return ldivmod(xs, ys);
 }
 
 /**
  * @brief Perform float true division.
- * @param x dividend integer part.
- * @param fx dividend fraction part.
- * @param y divisor integer part.
- * @param fy divisor fraction part.
- * @param * vectors of intergers 0-9.
- * @return quotient integer and fraction parts.
+ * @param x dividend magnitude * 10^fx.
+ * @param fx fraction digits of the dividend.
+ * @param y divisor magnitude * 10^fy.
+ * @param fy fraction digits of the divisor.
+ * @param precision maximum fraction digits of the quotient.
+ * @param mode rounding of the discarded digits.
+ * @param sign sign of the quotient.
+ * @param * vectors of limbs.
+ * @return quotient magnitude and its fraction digits.
  * @throw std::domain_error if division by zero.
  */
-const std::pair<std::vector<udigit>, std::vector<udigit>>
-true_div(const std::vector<udigit> &x, const std::vector<udigit> &fx,
-         const std::vector<udigit> &y, const std::vector<udigit> &fy)
+const std::pair<limb_vector, size_t>
+true_div(const limb_vector &x, const size_t fx,
+         const limb_vector &y, const size_t fy,
+         const size_t precision = getcontext().precision,
+         const rounding mode = getcontext().mode, const bool sign = false)
 {
-    size_t fx_size = fx.size();
-    size_t fy_size = fy.size();
-    if (fx_size == 1 && (fx.front() == 0))
-        fx_size = 0;
-    if (fy_size == 1 && (fy.front() == 0))
-        fy_size = 0;
-
-    std::vector<udigit> xfx, yfy;
-    xfx.reserve(x.size() + fx_size);
-    yfy.reserve(y.size() + fy_size);
-    xfx.assign(x.begin(), x.end());
-    yfy.assign(y.begin(), y.end());
-
-    if (fx_size) // if fx doesn't only contain zero
-        xfx.insert(xfx.end(), fx.begin(), fx.end());
-    if (fy_size) // if fy doesn't only contain zero
-        yfy.insert(yfy.end(), fy.begin(), fy.end());
-
-    if (fx_size < fy_size) // normalize denominator
-        xfx.insert(xfx.end(), fy_size - fx_size, 0);
-    else if (fx_size > fy_size) // normalize nominator
-        yfy.insert(yfy.end(), fx_size - fy_size, 0);
-
-    return true_div(xfx, yfy); // perform true division
+    limb_vector xs, ys;
+    common_scale(x, fx, y, fy, xs, ys);
+
+    /* perform integer division */
+    std::pair<limb_vector, limb_vector> div;
+    div = ldivmod(xs, ys);
+    if (div.second.empty()) // reached exact division
+        return {div.first, 0};
+
+    /* perform float division */
+    limb_vector &rem = div.second;
+    lmul_pow10(rem, precision);
+    std::pair<limb_vector, limb_vector> fdiv;
+    fdiv = ldivmod(rem, ys);
+
+    limb_vector &quot = div.first; // quot * 10^precision + fquot
+    lmul_pow10(quot, precision);
+    liadd(quot, fdiv.first);
+    // if didn't reach exact division
+    limb_vector &frem = fdiv.second;
+    const bool inexact = !frem.empty();
+    lmul_small(frem, 2); // compare remainder with half the divisor
+    const bool odd = !quot.empty() && (quot[0] & 1);
+    if (round_away(mode, sign, inexact, lcmp(frem, ys), odd))
+        liadd(quot, {1});
+
+    size_t frac = precision;
+    strip_fraction(quot, frac);
+    return {quot, frac};
+}
+
+/**
+ * @brief Perform inplace limb division by a machine integer.
+ * @param x dividend, receives the quotient.
+ * @param y divisor (non zero, less than MACHINE_LIMIT).
+ * @param * vector of limbs.
+ * @return remainder.
+ */
+uint64_t divmod_small(limb_vector &x, const uint64_t y)
+{
+    if (fits_machine(x, 0))
+    { // native division of machine words
+        const uint64_t a = to_machine(x);
+        from_machine(a / y, x);
+        return a % y;
+    }
+    if (y < LIMB_BASE)
+    {
+        limb rem;
+        x = ldivmod_small(x, static_cast<limb>(y), rem);
+        return rem;
+    }
+    limb_vector yl;
+    from_machine(y, yl);
+    std::pair<limb_vector, limb_vector> div = ldivmod(x, yl);
+    x.swap(div.first);
+    return to_machine(div.second);
+}
+
+/**
+ * @brief Perform inplace float multiplication by a machine integer.
+ * @param x multiplicand magnitude * 10^fx.
+ * @param fx fraction digits of the multiplicand.
+ * @param y multiplier (less than MACHINE_LIMIT).
+ * @param sign sign of the product.
+ * @param max_fraction maximum fraction digits of the product.
+ * @param mode rounding of the discarded digits.
+ * @param * vector of limbs.
+ */
+void imul_small(limb_vector &x, size_t &fx, const uint64_t y,
+                const bool sign = false,
+                const size_t max_fraction = getcontext().max_fraction,
+                const rounding mode = getcontext().mode)
+{
+    if (y < LIMB_BASE)
+        lmul_small(x, static_cast<limb>(y));
+    else
+    {
+        limb_vector yl;
+        from_machine(y, yl);
+        x = lmul(x, yl);
+    }
+    if (fx == 0)
+        return;
+    strip_fraction(x, fx);
+    fround(x, fx, max_fraction, sign, mode);
 }
 
 /* ========================================================
@@ -289,155 +342,464 @@ true_div(const std::vector<udigit> &x, const std::vector<udigit> &fx,
    =======================================================*/
 
 /**
- * @brief Perform inplace signed float addition.
- * @param x augend integer part.
- * @param fx augend fraction part.
- * @param y addend integer part.
- * @param fy addend fraction part.
+ * @brief Perform inplace signed addition of machine sized integers.
+ * @param x augend (less than MACHINE_LIMIT).
+ * @param b magnitude of the addend (less than MACHINE_LIMIT).
  * @param xsign sign of the augend.
  * @param ysign sign of the addend.
- * @param * vector of integers 0-9.
+ * @param * vector of limbs.
  * @return sign of the result.
  */
-bool signed_iadd(
-    std::vector<udigit> &x, std::vector<udigit> &fx,
-    const std::vector<udigit> &y, const std::vector<udigit> &fy,
-    const bool &xsign, const bool &ysign)
+bool machine_iadd(limb_vector &x, const uint64_t b,
+                  const bool xsign, const bool ysign)
 {
-    // positive
+    const uint64_t a = to_machine(x);
     if (xsign == ysign)
     {
-        iadd(x, fx, y, fy);
-        return xsign && ysign;
+        from_machine(a + b, x);
+        return xsign;
+    }
+    from_machine(a > b ? a - b : b - a, x);
+    return a == b ? false : (a > b ? xsign : ysign);
+}
+
+/**
+ * @brief Perform inplace signed float addition.
+ * @param x augend magnitude * 10^fx.
+ * @param fx fraction digits of the augend.
+ * @param y addend magnitude * 10^fy.
+ * @param fy fraction digits of the addend.
+ * @param xsign sign of the augend.
+ * @param ysign sign of the addend.
+ * @param max_fraction maximum fraction digits of the result.
+ * @param mode rounding of the discarded digits.
+ * @param * vectors of limbs.
+ * @return sign of the result.
+ * @attention the sum keeps the fraction digits of the finer operand.
+ */
+bool signed_iadd(
+    limb_vector &x, size_t &fx,
+    const limb_vector &y, const size_t fy,
+    const bool xsign, const bool ysign,
+    const size_t max_fraction = getcontext().max_fraction,
+    const rounding mode = getcontext().mode)
+{
+    if (fits_machine(x, fx) && fits_machine(y, fy))
+        return machine_iadd(x, to_machine(y), xsign, ysign);
+    if (fx < fy)
+    { // align x to the finer scale
+        lmul_pow10(x, fy - fx);
+        fx = fy;
+    }
+    bool sign;
+    if (fy < fx)
+    { // align a copy of y to the finer scale
+        limb_vector ys(y);
+        lmul_pow10(ys, fx - fy);
+        sign = signed_liadd(x, ys, xsign, ysign);
     }
-    // negative
-    const short icmp = cmp(x, y);
-    const short comp = (icmp == 0) ? fcmp(fx, fy) : icmp;
-    isub(x, fx, y, fy, icmp, comp);
-    if (comp == 0)
+    else
+        sign = signed_liadd(x, y, xsign, ysign);
+    if (x.empty() && xsign != ysign)
+    { // equal magnitudes cancel
+        fx = 0;
         return false;
-    return (comp == 1) ? xsign && !ysign : !xsign && ysign;
+    }
+    normalize_fraction(x, fx);
+    fround(x, fx, max_fraction, sign, mode);
+    return sign;
+}
+
+/**
+ * @brief Perform inplace signed addition of a machine integer.
+ * @param x augend magnitude * 10^fx.
+ * @param fx fraction digits of the augend.
+ * @param y magnitude of the addend.
+ * @param xsign sign of the augend.
+ * @param ysign sign of the addend.
+ * @param max_fraction maximum fraction digits of the result.
+ * @param mode rounding of the discarded digits.
+ * @param * vector of limbs.
+ * @return sign of the result.
+ */
+bool signed_iadd_small(
+    limb_vector &x, size_t &fx, const uint64_t y,
+    const bool xsign, const bool ysign,
+    const size_t max_fraction = getcontext().max_fraction,
+    const rounding mode = getcontext().mode)
+{
+    if (fits_machine(x, fx) && y < MACHINE_LIMIT)
+        return machine_iadd(x, y, xsign, ysign);
+    limb_vector yl;
+    from_machine(y, yl);
+    return signed_iadd(x, fx, yl, 0, xsign, ysign, max_fraction, mode);
 }
 
 /**
  * @brief Perform inplace signed float subtraction.
- * @param x minuend integer part.
- * @param fx minuend fraction part.
- * @param y subtrahend integer part.
- * @param fy subtrahend fraction part.
+ * @param x minuend magnitude * 10^fx.
+ * @param fx fraction digits of the minuend.
+ * @param y subtrahend magnitude * 10^fy.
+ * @param fy fraction digits of the subtrahend.
  * @param xsign sign of the minuend.
  * @param ysign sign of the subtrahend.
- * @param * vector of integers 0-9.
+ * @param max_fraction maximum fraction digits of the result.
+ * @param mode rounding of the discarded digits.
+ * @param * vectors of limbs.
  * @return sign of the result.
  */
-bool signed_isub(
-    std::vector<udigit> &x, std::vector<udigit> &fx,
-    const std::vector<udigit> &y, const std::vector<udigit> &fy,
-    const bool &xsign, const bool &ysign)
+inline bool signed_isub(
+    limb_vector &x, size_t &fx,
+    const limb_vector &y, const size_t fy,
+    const bool xsign, const bool ysign,
+    const size_t max_fraction = getcontext().max_fraction,
+    const rounding mode = getcontext().mode)
 {
-    // positive
-    if (xsign != ysign)
-    {
-        iadd(x, fx, y, fy);
-        return xsign && !ysign;
-    }
-    // negative
-    const short icmp = cmp(x, y);
-    const short comp = (icmp == 0) ? fcmp(fx, fy) : icmp;
-    isub(x, fx, y, fy, icmp, comp);
-    if (comp == 0)
-        return false;
-    return (comp == 1) ? xsign && ysign : !xsign && !ysign;
+    return signed_iadd(x, fx, y, fy, xsign, !ysign, max_fraction, mode);
 }
 
 /**
  * @brief Perform signed floor division.
- * @param x dividend integer part.
- * @param fx dividend fraction part.
- * @param y divisor integer part.
- * @param fy divisor fraction part.
+ * @param x dividend magnitude * 10^fx.
+ * @param fx fraction digits of the dividend.
+ * @param y divisor magnitude * 10^fy.
+ * @param fy fraction digits of the divisor.
  * @param xsign sign of the dividend.
  * @param ysign sign of the divisor.
- * @param * vector of integers 0-9.
+ * @param * vectors of limbs.
  * @return quotient and it's sign.
  * @throw std::domain_error if division by zero.
  */
-const std::pair<std::vector<udigit>, bool> signed_floor_div(
-    const std::vector<udigit> &x, const std::vector<udigit> &fx,
-    const std::vector<udigit> &y, const std::vector<udigit> &fy,
-    const bool &xsign, const bool &ysign)
+const std::pair<limb_vector, bool> signed_floor_div(
+    const limb_vector &x, const size_t fx,
+    const limb_vector &y, const size_t fy,
+    const bool xsign, const bool ysign)
 {
-    std::pair<std::vector<udigit>, double> div;
+    std::pair<limb_vector, limb_vector> div;
     div = divmod(x, fx, y, fy);
     if (xsign == ysign)
         return {div.first, false};
 
-    if (div.second != 0)
-    { // round towards negative infinity
-        std::vector<udigit> one(1, 1);
-        iadd(div.first, one);
-    }
+    if (!div.second.empty()) // round towards negative infinity
+        liadd(div.first, {1});
     return {div.first, true};
 }
 
+/**
+ * @brief Perform signed floor division by a machine integer.
+ * @param x dividend magnitude * 10^fx.
+ * @param fx fraction digits of the dividend.
+ * @param y magnitude of the divisor.
+ * @param xsign sign of the dividend.
+ * @param ysign sign of the divisor.
+ * @param * vector of limbs.
+ * @return quotient and it's sign.
+ * @throw std::domain_error if division by zero.
+ */
+const std::pair<limb_vector, bool> signed_floor_div_small(
+    const limb_vector &x, const size_t fx, const uint64_t y,
+    const bool xsign, const bool ysign)
+{
+    if (y == 0 || y >= MACHINE_LIMIT || fx)
+    { // general division
+        limb_vector yl;
+        from_machine(y, yl);
+        return signed_floor_div(x, fx, yl, 0, xsign, ysign);
+    }
+    limb_vector quot(x);
+    const uint64_t rem = divmod_small(quot, y);
+    if (xsign == ysign)
+        return {quot, false};
+    if (rem) // round towards negative infinity
+        liadd(quot, {1});
+    return {quot, true};
+}
+
 /**
  * @brief Perform inplace signed float modulus.
- * @param x dividend integer part.
- * @param fx dividend fraction part.
- * @param y divisor integer part.
- * @param fy divisor fraction part.
+ * @param x dividend magnitude * 10^fx.
+ * @param fx fraction digits of the dividend.
+ * @param y divisor magnitude * 10^fy.
+ * @param fy fraction digits of the divisor.
  * @param xsign sign of the dividend.
  * @param ysign sign of the divisor.
- * @param * vectors of intergers 0-9.
+ * @param * vectors of limbs.
+ * @return sign of the remainder.
  * @throw std::domain_error if division by zero.
  */
-bool signed_imod(std::vector<udigit> &x, std::vector<udigit> &fx,
-                 const std::vector<udigit> &y, const std::vector<udigit> &fy,
-                 const bool &xsign, const bool &ysign)
+bool signed_imod(limb_vector &x, size_t &fx,
+                 const limb_vector &y, const size_t fy,
+                 const bool xsign, const bool ysign)
 { // using formula: remainder = dividend - divisor * quotient
-    std::pair<std::vector<udigit>, bool> div;
+    std::pair<limb_vector, bool> div;
     div = signed_floor_div(x, fx, y, fy, xsign, ysign);
-    std::vector<udigit> zero(1, 0);
-    imul(div.first, zero, y, fy);
-    return signed_isub(x, fx, div.first, zero, xsign, div.second != ysign);
+    limb_vector prod = lmul(div.first, y);
+    size_t prod_frac = fy;
+    strip_fraction(prod, prod_frac);
+    return signed_isub(x, fx, prod, prod_frac, xsign, div.second != ysign);
+}
+
+/**
+ * @brief Perform inplace signed modulus by a machine integer.
+ * @param x dividend magnitude * 10^fx.
+ * @param fx fraction digits of the dividend.
+ * @param y magnitude of the divisor.
+ * @param xsign sign of the dividend.
+ * @param ysign sign of the divisor.
+ * @param * vector of limbs.
+ * @return sign of the remainder.
+ * @throw std::domain_error if division by zero.
+ */
+bool signed_imod_small(limb_vector &x, size_t &fx, const uint64_t y,
+                       const bool xsign, const bool ysign)
+{
+    if (y == 0 || y >= MACHINE_LIMIT || fx)
+    { // general modulus
+        limb_vector yl;
+        from_machine(y, yl);
+        return signed_imod(x, fx, yl, 0, xsign, ysign);
+    }
+    uint64_t rem = divmod_small(x, y);
+    if (rem && xsign != ysign) // remainder takes the divisor sign
+        rem = y - rem;
+    from_machine(rem, x);
+    return rem && ysign;
+}
+
+/**
+ * @brief Raise to a power keeping a bounded number of fraction digits.
+ * @param x base magnitude * 10^fx.
+ * @param fx fraction digits of the base.
+ * @param y exponent.
+ * @param work fraction digits kept after each step.
+ * @param max_fraction fraction digits of the result.
+ * @param mode rounding of the discarded digits.
+ * @param sign sign of the power.
+ * @param pow receives the power rounded to max_fraction digits.
+ * @param * vectors of limbs.
+ * @return false if the guard digits can't decide the rounding.
+ * @attention work must bound the accumulated truncation error below
+ * one unit of the digit after the guard limb.
+ */
+bool power_guard(const limb_vector &x, const size_t fx,
+                 const limb_vector &y, const size_t work,
+                 const size_t max_fraction, const rounding mode,
+                 const bool sign, limb_vector &pow)
+{
+    const size_t base_frac = std::min(fx, work);
+    const limb_vector base = truncate_fraction(x, fx, base_frac);
+    bool inexact = base_frac < fx;
+    const std::vector<bool> bits = lbits(y);
+    size_t frac = 0;
+    pow.assign(1, 1);
+    for (size_t i = bits.size(); i-- > 0;)
+    { // square and multiply, truncating every step to work digits
+        limb_vector prod = lsqr(pow);
+        frac *= 2;
+        if (bits[i])
+        {
+            prod = lmul(prod, base);
+            frac += base_frac;
+        }
+        if (frac > work)
+        {
+            inexact = ltruncate(prod, frac - work) || inexact;
+            frac = work;
+        }
+        pow.swap(prod);
+    }
+    if (!inexact)
+    { // nothing was lost, round the exact power
+        lround(pow, frac - max_fraction, mode, sign);
+        return true;
+    }
+    ltruncate(pow, frac - max_fraction - LIMB_DIGITS);
+    return lround_guard(pow, mode, sign);
 }
 
 /**
  * @brief Perform signed float power.
- * @param x base integer part.
- * @param fx base fraction part.
- * @param fx base fraction part.
- * @param y exponent integer part.
- * @param fy exponent fraction part.
+ * @param x base magnitude * 10^fx.
+ * @param fx fraction digits of the base.
+ * @param y exponent magnitude * 10^fy.
+ * @param fy fraction digits of the exponent.
  * @param xsign sign of the base.
  * @param ysign sign of the exponent.
- * @param * vector of integers 0-9.
- * @return base ** exp (integer and fraction parts).
+ * @param precision maximum fraction digits for negative exponents.
+ * @param max_fraction maximum fraction digits for positive exponents.
+ * @param mode rounding of the discarded digits.
+ * @param * vectors of limbs.
+ * @return base ** exp magnitude and its fraction digits.
  * @attention power sign is determined by the base sign.
  */
-const std::pair<std::vector<udigit>, std::vector<udigit>>
-signed_power(const std::vector<udigit> &x, const std::vector<udigit> &fx,
-             const std::vector<udigit> &y, const std::vector<udigit> &fy,
-             const bool &xsign, const bool &ysign)
+const std::pair<limb_vector, size_t>
+signed_power(const limb_vector &x, const size_t fx,
+             const limb_vector &y, const size_t fy,
+             const bool xsign, const bool ysign,
+             const size_t precision = getcontext().precision,
+             const size_t max_fraction = getcontext().max_fraction,
+             const rounding mode = getcontext().mode)
 {
-    const bool is_exp_frac_zero = (fy.size() == 1 && fy[0] == 0);
-    const bool is_frac_zeros = fx.size() == 1 && fx[0] == 0 && is_exp_frac_zero;
-
-    if (!is_exp_frac_zero)
+    if (fy)
         throw std::domain_error("can't power fractional exponent");
 
-    if (is_frac_zeros)
-        return signed_power(x, y, xsign, ysign);
+    if (fx == 0)
+    { // integer power
+        if (x.empty())
+            return {limb_vector(), 0};
+        if (y.empty())
+            return {limb_vector(1, 1), 0};
+        const limb_vector pow = lpow(x, y);
+        if (!ysign) // positive
+            return {pow, 0};
+        return true_div({1}, 0, pow, 0, precision, mode, xsign);
+    }
 
-    std::vector<udigit> exp = y;
-    std::vector<udigit> res_x(1, 1), res_fx(1, 0), one(1, 1);
-    for (; exp.front() != 0; isub(exp, one, cmp(exp, one)))
-    {
-        imul(res_x, res_fx, x, fx);
+    const size_t exp_size = std::max<size_t>(ldigits(y), 1);
+    if (exp_size > 19) // fraction digits of the power overflow
+        throw std::overflow_error("exponent too large");
+    const uint_fast64_t exp = to_machine(y);
+
+    size_t frac_size = fx * exp;
+    if (!ysign && frac_size > max_fraction)
+    { // truncation errors add up to less than 16 * exp^2 * max(1, x)^exp * 10^-work
+        const size_t size = ldigits(x);
+        const size_t int_size = size > fx ? size - fx : 0;
+        // x < (lead + 1) * 10^(int_size - k) for the k leading digits lead
+        double lead = 0;
+        size_t k = 0;
+        for (; k < 15 && k < size; ++k)
+            lead = lead * 10 + ldigit(x, size - 1 - k);
+        const double int_digits =
+            int_size == 0 ? 0 : exp * (std::log10(lead + 1) + static_cast<double>(int_size) -
+                                       static_cast<double>(k));
+        const size_t work = max_fraction + LIMB_DIGITS + 2 * exp_size + 4 +
+                            static_cast<size_t>(int_digits * (1 + 1e-9));
+        limb_vector pow;
+        if (int_digits < 1e15 && work < frac_size &&
+            power_guard(x, fx, y, work, max_fraction, mode, xsign, pow))
+        {
+            size_t frac = max_fraction;
+            strip_fraction(pow, frac);
+            return {pow, frac};
+        }
+    }
+
+    // (x / 10^fx) ** exp = x ** exp / 10^(fx * exp)
+    limb_vector pow = lpow(x, y);
+    if (!ysign && frac_size > max_fraction)
+    { // round the exact power
+        lround(pow, frac_size - max_fraction, mode, xsign);
+        frac_size = max_fraction;
     }
+    strip_fraction(pow, frac_size);
     if (!ysign) // positive
-        return {res_x, res_fx};
-    return true_div({1}, {0}, res_x, res_fx);
+        return {pow, frac_size};
+    return true_div({1}, 0, pow, frac_size, precision, mode, xsign);
+}
+
+/**
+ * @brief Perform signed float modular power.
+ * @param x base magnitude * 10^fx.
+ * @param fx fraction digits of the base.
+ * @param y exponent magnitude * 10^fy.
+ * @param fy fraction digits of the exponent.
+ * @param m modulus magnitude * 10^fm.
+ * @param fm fraction digits of the modulus.
+ * @param xsign sign of the base.
+ * @param ysign sign of the exponent.
+ * @param msign sign of the modulus.
+ * @param * vectors of limbs.
+ * @return base ** exp mod mod and sign of the result.
+ * @attention result sign is determined by the modulus sign.
+ * @throw std::domain_error if any argument has a fraction.
+ * @throw std::invalid_argument if modulus is zero or base is not invertible.
+ */
+const std::pair<limb_vector, bool>
+signed_powmod(const limb_vector &x, const size_t fx,
+              const limb_vector &y, const size_t fy,
+              const limb_vector &m, const size_t fm,
+              const bool xsign, const bool ysign, const bool msign)
+{
+    if (fx || fy || fm)
+        throw std::domain_error(
+            "pow() 3rd argument not allowed unless all arguments are integers");
+    if (m.empty())
+        throw std::invalid_argument("pow() 3rd argument cannot be 0");
+
+    limb_vector base = ldivmod(x, m).second;
+    if (xsign && !base.empty()) // reduce into [0, mod)
+    {
+        limb_vector res = m;
+        lisub(res, base);
+        base.swap(res);
+    }
+    if (ysign) // negative exponent uses the inverse
+        base = linvmod(base, m);
+
+    limb_vector res = lpowmod(base, y, m);
+    if (!msign || res.empty())
+        return {res, false};
+    limb_vector neg = m; // shift into (mod, 0]
+    lisub(neg, res);
+    return {neg, true};
+}
+
+/**
+ * @brief Calculate signed float n-th root.
+ * @param x radicand magnitude * 10^fx.
+ * @param fx fraction digits of the radicand.
+ * @param n degree of the root.
+ * @param sign sign of the radicand.
+ * @param precision maximum fraction digits of the root.
+ * @param mode rounding of the discarded digits.
+ * @param * vector of limbs.
+ * @return x ** (1 / n) magnitude and its fraction digits.
+ * @throw std::domain_error if even root of negative or zero degree.
+ * @throw std::overflow_error if degree too large.
+ */
+const std::pair<limb_vector, size_t>
+signed_root(const limb_vector &x, const size_t fx,
+            const size_t n, const bool sign,
+            const size_t precision = getcontext().precision,
+            const rounding mode = getcontext().mode)
+{
+    if (n == 0)
+        throw std::domain_error("zeroth root is undefined");
+    if (n >= LIMB_BASE)
+        throw std::overflow_error("root degree too large");
+    if (sign && n % 2 == 0 && !x.empty())
+        throw std::domain_error("even root of negative number");
+
+    // root(x / 10^fx) = root(x * 10^(n * p - fx)) / 10^p
+    const size_t scale = n * precision;
+    const limb degree = static_cast<limb>(n);
+
+    limb_vector num = x, den(1, 1);
+    if (scale >= fx)
+        lmul_pow10(num, scale - fx);
+    else
+        lmul_pow10(den, fx - scale);
+    limb_vector quot = num;
+    if (scale < fx) // floor(num / den)
+        lround(quot, fx - scale, ROUND_DOWN, false);
+    limb_vector root = lroot(quot, degree);
+
+    // inexact if root^n * den != num, half by 2^n * num <=> (2 * root + 1)^n * den
+    const limb_vector exp(1, degree);
+    const bool inexact = lcmp(lmul(lpow(root, exp), den), num) != 0;
+    limb_vector upper = root;
+    lmul_small(upper, 2);
+    liadd(upper, {1});
+    limb_vector twice = lpow({2}, exp);
+    const short half = lcmp(lmul(twice, num), lmul(lpow(upper, exp), den));
+    const bool odd = !root.empty() && (root[0] & 1);
+    if (round_away(mode, sign, inexact, half, odd))
+        liadd(root, {1});
+
+    size_t frac = precision;
+    strip_fraction(root, frac);
+    return {root, frac};
 }
 
-#endif // FMATH_H
\ No newline at end of file
+#endif // FMATH_H
@@ -4,39 +4,29 @@
 #include <vector>
 #include <cassert>
 #include "utils.h"
+#include "lmath.h"
+#include "context.h"
+#include "simd.h"
 
 /**
  * @brief Perform inplace addition.
  * @param x augend.
  * @param y addend.
+ * @param carry carry into the least significant digit.
  * @param * vector of integers 0-9.
  */
-void iadd(std::vector<udigit> &x, const std::vector<udigit> &y)
+void iadd(digit_vector &x, const digit_vector &y, const udigit carry = 0)
 {
-    const size_t x_size = x.size(), y_size = y.size();
-    const size_t max_size = std::max(x_size, y_size);
-    if (x_size < y_size)
-        x.resize(y_size);
+    const size_t y_size = y.size();
+    if (x.size() < y_size)
+        x.insert(x.begin(), y_size - x.size(), 0);
 
-    auto xi = x.rbegin();
-    auto yi = y.rbegin();
-
-    // skip zeros caused from resizing.
-    if (x_size < y_size)
-        xi += y_size - x_size;
-
-    udigit nx, ny, res, carry = 0;
-    for (int64_t i = max_size - 1; i > -1; --i)
-    {
-        nx = xi != x.rend() ? *xi++ : 0;
-        ny = yi != y.rend() ? *yi++ : 0;
-        res = nx + ny + carry;
-        carry = (res < 10) ? 0 : (res -= 10, 1);
-        x[i] = res;
-    }
-    if (!carry)
+    const size_t lead = x.size() - y_size;
+    udigit c = add_digits(x.data() + lead, y.data(), y_size, carry);
+    c = carry_digits(x.data(), lead, c);
+    if (!c)
         return;
-    x.insert(x.begin(), carry);
+    x.insert(x.begin(), c);
 }
 
 /**
@@ -44,9 +34,11 @@ void iadd(std::vector<udigit> &x, const std::vector<udigit> &y)
  * @param x minuend.
  * @param y subtrahend.
  * @param comp comparison of x and y.
+ * @param borrow borrow from the least significant digit.
  * @param * vector of integers 0-9.
  */
-void isub(std::vector<udigit> &x, const std::vector<udigit> &y, const short &comp)
+void isub(digit_vector &x, const digit_vector &y, const short &comp,
+          const udigit borrow = 0)
 {
     if (comp == 0)
     {
@@ -55,33 +47,24 @@ void isub(std::vector<udigit> &x, const std::vector<udigit> &y, const short &com
     }
     const bool rev_sub = comp == -1;
 
-    std::vector<udigit> *px = &x, *py;
-    py = const_cast<std::vector<udigit> *>(&y);
-    const size_t x_size = x.size(), y_size = y.size();
-    const size_t max_size = std::max(x_size, y_size);
-    if (x_size < y_size)
-        x.resize(y_size);
-    if (rev_sub)
-        std::swap(px, py);
-
-    auto xi = px->rbegin();
-    auto yi = py->rbegin();
-    // skip zeros caused from resizing.
-    if (x_size < y_size)
-        (rev_sub ? yi : xi) += y_size - x_size;
+    const size_t y_size = y.size();
+    if (x.size() < y_size)
+        x.insert(x.begin(), y_size - x.size(), 0);
 
-    int_fast8_t res;
-    udigit nx, ny, borrow = 0;
-    for (int64_t i = max_size - 1; i > -1; --i)
+    udigit b;
+    if (rev_sub)
+    { // x = y - x, x is never longer than y
+        assert(x.size() == y_size && "invalid subtraction");
+        b = sub_digits(x.data(), y.data(), y_size, borrow, true);
+    }
+    else
     {
-        nx = xi != px->rend() ? *xi++ : 0;
-        ny = yi != py->rend() ? *yi++ : 0;
-        res = nx - ny - borrow;
-        borrow = res >= 0 ? 0 : 1;
-        res = borrow ? res + 10 : res;
-        x[i] = res;
+        const size_t lead = x.size() - y_size;
+        b = sub_digits(x.data() + lead, y.data(), y_size, borrow);
+        b = borrow_digits(x.data(), lead, b);
     }
-    assert(borrow == 0 && "invalid subtraction");
+    assert(b == 0 && "invalid subtraction");
+    (void)b;
     lstrip_zeros(x);
 }
 
@@ -92,24 +75,36 @@ void isub(std::vector<udigit> &x, const std::vector<udigit> &y, const short &com
  * @param * vector of integers 0-9.
  * @return product of the multiplicand and multiplier.
  */
-const std::vector<udigit> mul(const std::vector<udigit> &x, const std::vector<udigit> &y)
+const digit_vector mul(const digit_vector &x, const digit_vector &y)
 {
-    std::vector<udigit> result(x.size() + y.size(), 0);
-    for (auto xi = x.rbegin(); xi != x.rend(); ++xi)
-    {
-        udigit carry = 0;
-        auto res_it = result.rbegin() + (xi - x.rbegin());
-
-        for (auto yi = y.rbegin(); yi != y.rend(); ++yi, ++res_it)
-        {
-            udigit prod = *xi * *yi + carry + *res_it;
-            carry = prod / 10;
-            *res_it = prod % 10;
-        }
-        *res_it += carry;
+    digit_vector res;
+#ifdef __SIZEOF_INT128__
+    if (x.size() <= MACHINE_DIGITS && y.size() <= MACHINE_DIGITS)
+    { // native product of machine words
+        from_machine(static_cast<unsigned __int128>(to_machine(x)) * to_machine(y), res);
+        return res;
     }
-    lstrip_zeros(result);
-    return result;
+#else
+    if (x.size() + y.size() <= MACHINE_DIGITS)
+    { // native product of machine words
+        from_machine(to_machine(x) * to_machine(y), res);
+        return res;
+    }
+#endif
+    return from_limbs(lmul(to_limbs(x), to_limbs(y)));
+}
+
+/**
+ * @brief Perform integer squaring.
+ * @param x number to square.
+ * @param * vector of integers 0-9.
+ * @return x * x.
+ */
+const digit_vector sqr(const digit_vector &x)
+{
+    if (x.size() <= MACHINE_DIGITS)
+        return mul(x, x);
+    return from_limbs(lsqr(to_limbs(x)));
 }
 
 /**
@@ -120,81 +115,67 @@ const std::vector<udigit> mul(const std::vector<udigit> &x, const std::vector<ud
  * @return quotient and remainder.
  * @throw std::domain_error if division by zero.
  */
-inline const std::pair<std::vector<udigit>, double>
-divmod(const std::vector<udigit> &x, const std::vector<udigit> &y)
+inline const std::pair<digit_vector, digit_vector>
+divmod(const digit_vector &x, const digit_vector &y)
 {
-    double divisor = y.front();
-    for (auto it = next(y.begin()); it != y.end(); ++it)
-        divisor = divisor * 10 + *it;
-
-    if (divisor == 0)
-        throw std::domain_error("division by zero");
-
-    std::vector<udigit> quot;
-    udigit quot_div;
-    double term_minus, minus_term, rem = 0.0;
-    for (auto ix = x.begin(); ix != x.end(); ++ix)
-    {
-        term_minus = rem * 10 + *ix;
-        quot_div = static_cast<udigit>(term_minus / divisor);
-        minus_term = divisor * quot_div;
-        rem = term_minus - minus_term;
-        quot.push_back(quot_div);
+    const uint64_t b = y.size() <= MACHINE_DIGITS ? to_machine(y) : 0;
+    if (x.size() <= MACHINE_DIGITS && b != 0)
+    { // native division of machine words
+        const uint64_t a = to_machine(x);
+        std::pair<digit_vector, digit_vector> res;
+        from_machine(a / b, res.first);
+        from_machine(a % b, res.second);
+        return res;
     }
-    lstrip_zeros(quot);
-    return {quot, rem};
+    std::pair<limb_vector, limb_vector> div;
+    div = ldivmod(to_limbs(x), to_limbs(y));
+    return {from_limbs(div.first), from_limbs(div.second)};
 }
 
 /**
  * @brief Perform  true division.
  * @param x dividend.
  * @param y divisor.
+ * @param precision maximum fraction digits of the quotient.
+ * @param mode rounding of the discarded digits.
+ * @param sign sign of the quotient.
  * @param * vectors of intergers 0-9.
  * @return quotient integer and fraction parts.
  * @throw std::domain_error if division by zero.
  */
-const std::pair<std::vector<udigit>, std::vector<udigit>>
-true_div(const std::vector<udigit> &x, const std::vector<udigit> &y)
+const std::pair<digit_vector, digit_vector>
+true_div(const digit_vector &x, const digit_vector &y,
+         const size_t precision = getcontext().precision,
+         const rounding mode = getcontext().mode, const bool sign = false)
 {
-    double divisor = y.front();
-    for (auto it = next(y.begin()); it != y.end(); ++it)
-        divisor = divisor * 10 + *it;
-
-    if (divisor == 0)
-        throw std::domain_error("division by zero");
+    const limb_vector ly = to_limbs(y);
 
     /* perform integer division */
-    std::vector<udigit> quot;
-    udigit quot_div;
-    double term_minus, minus_term, rem = 0.0;
-    for (auto ix = x.begin(); ix != x.end(); ++ix)
-    {
-        term_minus = rem * 10 + *ix;
-        quot_div = static_cast<udigit>(term_minus / divisor);
-        minus_term = divisor * quot_div;
-        rem = term_minus - minus_term;
-        quot.push_back(quot_div);
-    }
-    lstrip_zeros(quot);
-    if (rem == 0) // reached exact division
-        return {quot, {0}};
+    std::pair<limb_vector, limb_vector> div;
+    div = ldivmod(to_limbs(x), ly);
+    if (div.second.empty()) // reached exact division
+        return {from_limbs(div.first), {0}};
 
     /* perform float division */
-    constexpr size_t precision = 20U;
-    std::vector<udigit> fquot;
-    fquot.reserve(precision);
-    for (size_t i = 0; i < precision && rem; ++i)
-    {
-        term_minus = rem * 10;
-        quot_div = static_cast<udigit>(term_minus / divisor);
-        minus_term = divisor * quot_div;
-        rem = term_minus - minus_term;
-        fquot.push_back(quot_div);
-    }
+    limb_vector &rem = div.second;
+    lmul_pow10(rem, precision);
+    std::pair<limb_vector, limb_vector> fdiv;
+    fdiv = ldivmod(rem, ly);
+
+    limb_vector &quot = div.first; // quot * 10^precision + fquot
+    lmul_pow10(quot, precision);
+    liadd(quot, fdiv.first);
     // if didn't reach exact division
-    if (rem != 0) // round by one
-        iadd(fquot, {1});
-    return {quot, fquot};
+    limb_vector &frem = fdiv.second;
+    const bool inexact = !frem.empty();
+    lmul_small(frem, 2); // compare remainder with half the divisor
+    const bool odd = !quot.empty() && (quot[0] & 1);
+    if (round_away(mode, sign, inexact, lcmp(frem, ly), odd))
+        liadd(quot, {1});
+
+    std::pair<digit_vector, digit_vector> result;
+    split_digits(from_limbs(quot), precision, result.first, result.second);
+    return result;
 }
 
 /**
@@ -204,19 +185,269 @@ true_div(const std::vector<udigit> &x, const std::vector<udigit> &y)
  * @param * vector of integers 0-9.
  * @return base ** exp.
  */
-inline const std::vector<udigit>
-power(const std::vector<udigit> &base, std::vector<udigit> exp)
+inline const digit_vector
+power(const digit_vector &base, const digit_vector &exp)
 {
-    std::vector<udigit> result(1, 1), one(1, 1);
-    for (; exp.front() != 0; isub(exp, one, cmp(exp, one)))
-    {
-        std::vector<udigit> prod;
-        prod = mul(result, base);
-        result.swap(prod);
-    }
+    return from_limbs(lpow(to_limbs(base), to_limbs(exp)));
+}
+
+/**
+ * @brief Calculate the integer square root.
+ * @param x radicand.
+ * @param * vector of integers 0-9.
+ * @return floor(sqrt(x)).
+ */
+inline const digit_vector isqrt(const digit_vector &x)
+{
+    return from_limbs(lroot(to_limbs(x), 2));
+}
+
+/* ========================================================
+   *                MACHINE INTEGER OPERANDS              *
+   =======================================================*/
+
+/**
+ * @brief Digits per chunk of the small kernels, chunk * y < 10^19.
+ * @param y machine integer operand (less than MACHINE_LIMIT).
+ */
+inline size_t small_chunk(const uint64_t y) noexcept
+{
+    size_t size = 1;
+    for (uint64_t tens = 10; tens <= y; tens *= 10)
+        ++size;
+    return 19 - size;
+}
+
+/**
+ * @brief Calculate a power of ten below 10^19.
+ */
+inline uint64_t small_pow10(size_t exp) noexcept
+{
+    uint64_t result = 1;
+    while (exp--)
+        result *= 10;
     return result;
 }
 
+/**
+ * @brief Read digits as a machine word.
+ */
+inline uint64_t load_digits(const udigit *x, size_t size) noexcept
+{
+    uint64_t value = 0;
+    for (; size > LIMB_DIGITS; size -= LIMB_DIGITS, x += LIMB_DIGITS)
+    { // 9 digits at a time, as two independent 32 bit chains
+        limb high = 0, low = 0;
+        for (size_t i = 0; i < 4; ++i)
+            high = high * 10 + x[i];
+        for (size_t i = 4; i < LIMB_DIGITS; ++i)
+            low = low * 10 + x[i];
+        value = value * LIMB_BASE + high * 100000U + low;
+    }
+    limb part = 0, scale = 1;
+    for (size_t i = 0; i < size; ++i, scale *= 10)
+        part = part * 10 + x[i];
+    return value * scale + part;
+}
+
+/**
+ * @brief Write a machine word as a fixed number of digits.
+ */
+inline void store_digits(udigit *x, size_t size, uint64_t value) noexcept
+{
+    for (; size > LIMB_DIGITS; size -= LIMB_DIGITS, value /= LIMB_BASE)
+    { // 9 digits at a time, as two independent 32 bit chains
+        const limb part = static_cast<limb>(value % LIMB_BASE);
+        limb high = part / 100000U, low = part % 100000U;
+        udigit *ptr = x + size - LIMB_DIGITS;
+        for (size_t i = 5; i > 0; --i, low /= 10)
+            ptr[i + 3] = low % 10;
+        for (size_t i = 4; i > 0; --i, high /= 10)
+            ptr[i - 1] = high % 10;
+    }
+    for (limb part = static_cast<limb>(value); size > 0; --size, part /= 10)
+        x[size - 1] = part % 10;
+}
+
+/**
+ * @brief Insert the digits of a machine word before x.
+ * @param x vector of integers 0-9.
+ * @param value machine word to insert, nothing if zero.
+ */
+void prepend_machine(digit_vector &x, const uint64_t value)
+{
+    if (value == 0)
+        return;
+    digit_vector high;
+    from_machine(value, high);
+    x.insert(x.begin(), high.begin(), high.end());
+}
+
+/**
+ * @brief Multiply digits in place by a machine integer.
+ * @param x digits, most significant first.
+ * @param size number of digits.
+ * @param y multiplier (less than MACHINE_LIMIT).
+ * @param carry carry into the least significant digit (at most y).
+ * @return carry out of the most significant digit.
+ */
+uint64_t mul_digits_small(udigit *x, size_t size, const uint64_t y, uint64_t carry) noexcept
+{
+    const size_t chunk = small_chunk(y);
+    const uint64_t base = small_pow10(chunk);
+    while (size)
+    { // least significant chunk first
+        const size_t n = std::min(size, chunk);
+        udigit *ptr = x + size - n;
+        const uint64_t value = load_digits(ptr, n) * y + carry;
+        const uint64_t unit = (n == chunk) ? base : small_pow10(n);
+        store_digits(ptr, n, value % unit);
+        carry = value / unit;
+        size -= n;
+    }
+    return carry;
+}
+
+/**
+ * @brief Divide digits by a machine integer.
+ * @param x digits, most significant first.
+ * @param size number of digits.
+ * @param y divisor (nonzero, less than MACHINE_LIMIT).
+ * @param quot digits receiving the quotient (may be x), nullptr to skip.
+ * @return remainder.
+ */
+uint64_t div_digits_small(const udigit *x, const size_t size,
+                          const uint64_t y, udigit *quot) noexcept
+{
+    const size_t chunk = small_chunk(y);
+    const uint64_t base = small_pow10(chunk);
+    size_t n = size % chunk ? size % chunk : chunk; // leading chunk
+    uint64_t rem = 0;
+    for (size_t i = 0; i < size; i += n, n = chunk)
+    { // most significant chunk first
+        const uint64_t value = rem * (n == chunk ? base : small_pow10(n)) +
+                               load_digits(x + i, n);
+        if (quot)
+            store_digits(quot + i, n, value / y);
+        rem = value % y;
+    }
+    return rem;
+}
+
+/**
+ * @brief Perform inplace addition of a machine integer.
+ * @param x augend.
+ * @param y addend.
+ * @param * vector of integers 0-9.
+ */
+void iadd_small(digit_vector &x, uint64_t y)
+{
+    udigit *begin = x.data();
+    udigit *ptr = begin + x.size();
+    while (y && ptr != begin)
+    { // stops as soon as the carry dies out
+        const uint64_t sum = *--ptr + y % 10;
+        *ptr = sum % 10;
+        y = y / 10 + sum / 10;
+    }
+    prepend_machine(x, y);
+}
+
+/**
+ * @brief Perform inplace subtraction of a machine integer.
+ * @param x minuend (not less than y).
+ * @param y subtrahend.
+ * @param * vector of integers 0-9.
+ */
+void isub_small(digit_vector &x, uint64_t y) noexcept
+{
+    udigit *begin = x.data();
+    udigit *ptr = begin + x.size();
+    while (y)
+    { // stops as soon as the borrow dies out
+        assert(ptr != begin && "invalid subtraction");
+        const udigit digit = y % 10;
+        y /= 10;
+        if (*--ptr >= digit)
+            *ptr -= digit;
+        else
+        {
+            *ptr += 10 - digit;
+            ++y;
+        }
+    }
+    lstrip_zeros(x);
+}
+
+/**
+ * @brief Perform inplace multiplication by a machine integer.
+ * @param x multiplicand.
+ * @param y multiplier (less than MACHINE_LIMIT).
+ * @param * vector of integers 0-9.
+ */
+void imul_small(digit_vector &x, const uint64_t y)
+{
+#ifdef __SIZEOF_INT128__
+    if (x.size() <= MACHINE_DIGITS)
+    { // native product of machine words
+        from_machine(static_cast<unsigned __int128>(to_machine(x)) * y, x);
+        return;
+    }
+#endif
+    prepend_machine(x, mul_digits_small(x.data(), x.size(), y, 0));
+    lstrip_zeros(x);
+}
+
+/**
+ * @brief Perform inplace division by a machine integer.
+ * @param x dividend, receives the quotient.
+ * @param y divisor (nonzero, less than MACHINE_LIMIT).
+ * @param * vector of integers 0-9.
+ * @return remainder.
+ */
+uint64_t divmod_small(digit_vector &x, const uint64_t y)
+{
+    const uint64_t rem = div_digits_small(x.data(), x.size(), y, x.data());
+    lstrip_zeros(x);
+    return rem;
+}
+
+/**
+ * @brief Calculate the remainder of division by a machine integer.
+ * @param x dividend.
+ * @param y divisor (nonzero, less than MACHINE_LIMIT).
+ * @param * vector of integers 0-9.
+ * @return x % y.
+ */
+inline uint64_t mod_small(const digit_vector &x, const uint64_t y) noexcept
+{
+    return div_digits_small(x.data(), x.size(), y, nullptr);
+}
+
+/**
+ * Compare a vector of integers with a machine integer.
+ *
+ * @param x vector of integers 0-9.
+ * @param y machine integer.
+ * @return 0 if x == y, -1 if x < y, 1 if x > y.
+ */
+short cmp_small(const digit_vector &x, const uint64_t y) noexcept
+{
+    const size_t size = x.size();
+    if (size > 20) // 10^20 > UINT64_MAX
+        return 1;
+    if (size == 20)
+    { // compare all but the last digit first
+        const uint64_t high = load_digits(x.data(), 19);
+        if (high != y / 10)
+            return high > y / 10 ? 1 : -1;
+        const udigit low = x[19];
+        return low == y % 10 ? 0 : (low > y % 10 ? 1 : -1);
+    }
+    const uint64_t value = to_machine(x);
+    return value == y ? 0 : (value > y ? 1 : -1);
+}
+
 /* ========================================================
    *                 SIGNED OPERATIONS                    *
    =======================================================*/
@@ -227,24 +458,68 @@ power(const std::vector<udigit> &base, std::vector<udigit> exp)
  * @param exp base raised to this power.
  * @param xsign sign of the base.
  * @param ysign sign of the exponent.
+ * @param precision maximum fraction digits for negative exponents.
+ * @param mode rounding of the discarded digits.
  * @param * vector of integers 0-9.
  * @return base ** exp (integer and fraction parts).
  * @attention power sign is determined by the base sign.
  */
-const std::pair<std::vector<udigit>, std::vector<udigit>>
-signed_power(const std::vector<udigit> &base, const std::vector<udigit> &exp,
-             const bool &xsign, const bool &ysign)
+const std::pair<digit_vector, digit_vector>
+signed_power(const digit_vector &base, const digit_vector &exp,
+             const bool &xsign, const bool &ysign,
+             const size_t precision = getcontext().precision,
+             const rounding mode = getcontext().mode)
 {
     if (base.size() == 1 && base.front() == 0)
         return {{0}, {0}};
 
     if (exp.size() == 1 && exp.front() == 0)
-        return {{1}, base};
+        return {{1}, {0}};
 
-    const std::vector<udigit> pow = power(base, exp);
+    const digit_vector pow = power(base, exp);
     if (!ysign) // positive
         return {pow, {0}};
-    return true_div({1}, pow);
+    return true_div({1}, pow, precision, mode, xsign);
+}
+
+/**
+ * @brief Calculate signed modular power.
+ * @param base number being raised.
+ * @param exp base raised to this power.
+ * @param mod modulus.
+ * @param xsign sign of the base.
+ * @param ysign sign of the exponent.
+ * @param msign sign of the modulus.
+ * @param * vector of integers 0-9.
+ * @return base ** exp mod mod and sign of the result.
+ * @attention result sign is determined by the modulus sign.
+ * @throw std::invalid_argument if modulus is zero or base is not invertible.
+ */
+const std::pair<digit_vector, bool>
+signed_powmod(const digit_vector &base, const digit_vector &exp,
+              const digit_vector &mod, const bool &xsign,
+              const bool &ysign, const bool &msign)
+{
+    const limb_vector lmod = to_limbs(mod);
+    if (lmod.empty())
+        throw std::invalid_argument("pow() 3rd argument cannot be 0");
+
+    limb_vector lbase = ldivmod(to_limbs(base), lmod).second;
+    if (xsign && !lbase.empty()) // reduce into [0, mod)
+    {
+        limb_vector res = lmod;
+        lisub(res, lbase);
+        lbase.swap(res);
+    }
+    if (ysign) // negative exponent uses the inverse
+        lbase = linvmod(lbase, lmod);
+
+    limb_vector res = lpowmod(lbase, to_limbs(exp), lmod);
+    if (!msign || res.empty())
+        return {from_limbs(res), false};
+    limb_vector neg = lmod; // shift into (mod, 0]
+    lisub(neg, res);
+    return {from_limbs(neg), true};
 }
 
 #endif // IMATH_H
\ No newline at end of file
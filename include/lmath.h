@@ -0,0 +1,1588 @@
+#ifndef LMATH_H
+#define LMATH_H
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cassert>
+#include <stdexcept>
+#include "utils.h"
+#include "context.h"
+
+// operand size (in limbs) from which karatsuba replaces schoolbook.
+constexpr size_t KARATSUBA_THRESHOLD = 32U;
+// operand size (in limbs) from which toom-3 replaces karatsuba.
+constexpr size_t TOOM3_THRESHOLD = 300U;
+// operand size (in limbs) from which the number theoretic transform is used.
+constexpr size_t NTT_THRESHOLD = 2000U;
+
+// divisor size (in limbs) from which burnikel-ziegler replaces long division.
+constexpr size_t BZ_THRESHOLD = 40U;
+// products summed before a schoolbook column is carried.
+constexpr size_t COMBA_BLOCK = 16U;
+// divisor limbs from which repeated barrett steps beat schoolbook division.
+constexpr size_t BARRETT_THRESHOLD = 8U;
+
+// primes of the form c * 2^k + 1 (primitive root 3) used by the transform.
+constexpr uint32_t NTT_P1 = 998244353U; // 119 * 2^23 + 1
+constexpr uint32_t NTT_P2 = 167772161U; // 5 * 2^25 + 1
+constexpr uint32_t NTT_P3 = 469762049U; // 7 * 2^26 + 1
+// longest transform supported by all three primes.
+constexpr size_t NTT_MAX_SIZE = static_cast<size_t>(1) << 23;
+
+/**
+ * @brief Remove high zero limbs.
+ * @param x vector of limbs to modify.
+ */
+inline void trim_limbs(limb_vector &x) noexcept
+{
+    while (!x.empty() && x.back() == 0)
+        x.pop_back();
+}
+
+/**
+ * @brief Get the size of a limb range without high zero limbs.
+ * @param x pointer to the limbs.
+ * @param size number of limbs.
+ */
+inline size_t trim_size(const limb *x, size_t size) noexcept
+{
+    while (size && x[size - 1] == 0)
+        --size;
+    return size;
+}
+
+/**
+ * Compare two vectors of limbs.
+ *
+ * @param x The first vector of limbs to compare.
+ * @param y The second vector of limbs to compare.
+ * @return 0 if x == y, -1 if x < y, 1 if x > y.
+ */
+short lcmp(const limb_vector &x, const limb_vector &y) noexcept
+{
+    const size_t s1 = x.size();
+    const size_t s2 = y.size();
+    if (s1 != s2)
+        return s1 > s2 ? 1 : -1;
+    for (size_t i = s1; i > 0; --i)
+    {
+        if (x[i - 1] == y[i - 1])
+            continue;
+        return x[i - 1] > y[i - 1] ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Perform inplace limb range addition.
+ * @param x augend (x_size >= y_size).
+ * @param y addend.
+ * @return carry out of the most significant limb.
+ */
+inline limb add_limbs(limb *x, const size_t x_size,
+                      const limb *y, const size_t y_size) noexcept
+{
+    limb carry = 0;
+    size_t i = 0;
+    for (; i < y_size; ++i)
+    {
+        limb res = x[i] + y[i] + carry;
+        carry = (res < LIMB_BASE) ? 0 : (res -= LIMB_BASE, 1);
+        x[i] = res;
+    }
+    for (; carry && i < x_size; ++i)
+    {
+        limb res = x[i] + carry;
+        carry = (res < LIMB_BASE) ? 0 : (res -= LIMB_BASE, 1);
+        x[i] = res;
+    }
+    return carry;
+}
+
+/**
+ * @brief Perform inplace limb range subtraction.
+ * @param x minuend (x_size >= y_size).
+ * @param y subtrahend.
+ * @return borrow out of the most significant limb.
+ */
+inline limb sub_limbs(limb *x, const size_t x_size,
+                      const limb *y, const size_t y_size) noexcept
+{
+    limb borrow = 0;
+    size_t i = 0;
+    for (; i < y_size; ++i)
+    {
+        const limb sub = y[i] + borrow;
+        borrow = x[i] < sub;
+        x[i] = borrow ? x[i] + LIMB_BASE - sub : x[i] - sub;
+    }
+    for (; borrow && i < x_size; ++i)
+    {
+        borrow = x[i] == 0;
+        x[i] = borrow ? LIMB_BASE - 1 : x[i] - 1;
+    }
+    return borrow;
+}
+
+/**
+ * @brief Perform inplace limb addition.
+ * @param x augend.
+ * @param y addend.
+ * @param * vector of limbs.
+ */
+void liadd(limb_vector &x, const limb_vector &y)
+{
+    if (x.size() < y.size())
+        x.resize(y.size(), 0);
+    const limb carry = add_limbs(x.data(), x.size(), y.data(), y.size());
+    if (carry)
+        x.push_back(carry);
+}
+
+/**
+ * @brief Perform inplace limb subtraction.
+ * @param x minuend (x >= y).
+ * @param y subtrahend.
+ * @param * vector of limbs.
+ */
+void lisub(limb_vector &x, const limb_vector &y) noexcept
+{
+    sub_limbs(x.data(), x.size(), y.data(), y.size());
+    trim_limbs(x);
+}
+
+/**
+ * @brief Perform inplace signed limb addition.
+ * @param x augend.
+ * @param y addend.
+ * @param xsign sign of the augend.
+ * @param ysign sign of the addend.
+ * @param * vector of limbs.
+ * @return sign of the result.
+ */
+bool signed_liadd(limb_vector &x, const limb_vector &y,
+                  const bool xsign, const bool ysign)
+{
+    if (xsign == ysign)
+    {
+        liadd(x, y);
+        return xsign;
+    }
+    const short comp = lcmp(x, y);
+    if (comp >= 0)
+    {
+        lisub(x, y);
+        return comp == 0 ? false : xsign;
+    }
+    limb_vector res = y;
+    lisub(res, x);
+    x.swap(res);
+    return ysign;
+}
+
+/**
+ * @brief Perform inplace limb multiplication by a single limb.
+ * @param x multiplicand.
+ * @param y multiplier.
+ * @param * vector of limbs.
+ */
+void lmul_small(limb_vector &x, const limb y)
+{
+    dlimb carry = 0;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        const dlimb prod = static_cast<dlimb>(x[i]) * y + carry;
+        carry = prod / LIMB_BASE;
+        x[i] = static_cast<limb>(prod % LIMB_BASE);
+    }
+    if (carry)
+        x.push_back(static_cast<limb>(carry));
+    trim_limbs(x);
+}
+
+/**
+ * @brief Perform inplace exact limb division by a single limb.
+ * @param x dividend, must be a multiple of y.
+ * @param y divisor (non zero).
+ * @param * vector of limbs.
+ */
+void ldivexact_small(limb_vector &x, const limb y) noexcept
+{
+    dlimb rem = 0;
+    for (size_t i = x.size(); i > 0; --i)
+    {
+        const dlimb cur = rem * LIMB_BASE + x[i - 1];
+        x[i - 1] = static_cast<limb>(cur / y);
+        rem = cur % y;
+    }
+    assert(rem == 0 && "inexact division");
+    trim_limbs(x);
+}
+
+/**
+ * @brief Perform schoolbook limb multiplication.
+ * @param res product of x_size + y_size limbs.
+ * @param x multiplicand.
+ * @param y multiplier.
+ * @attention products are summed by column and carried once per
+ * COMBA_BLOCK products, (LIMB_BASE - 1)^2 * COMBA_BLOCK fits a dlimb.
+ */
+void mul_basecase(limb *res, const limb *x, const size_t x_size,
+                  const limb *y, const size_t y_size) noexcept
+{
+    if (x_size < y_size)
+        return mul_basecase(res, y, y_size, x, x_size);
+    dlimb carry = 0;
+    for (size_t k = 0; k + 1 < x_size + y_size; ++k)
+    { // column k sums x[i] * y[k - i]
+        const size_t first = k < y_size ? 0 : k - y_size + 1;
+        const size_t last = std::min(k + 1, x_size);
+        dlimb acc = carry, high = 0; // carry is far below the headroom of a block
+        for (size_t i = first; i < last;)
+        {
+            const size_t end = std::min(last, i + COMBA_BLOCK);
+            for (; i < end; ++i)
+                acc += static_cast<dlimb>(x[i]) * y[k - i];
+            high += acc / LIMB_BASE;
+            acc %= LIMB_BASE;
+        }
+        res[k] = static_cast<limb>(acc);
+        carry = high;
+    }
+    res[x_size + y_size - 1] = static_cast<limb>(carry);
+}
+
+void mul_limbs(limb *res, const limb *x, size_t x_size,
+               const limb *y, size_t y_size);
+void sqr_limbs(limb *res, const limb *x, const size_t size);
+const limb_vector lmul(const limb_vector &x, const limb_vector &y);
+const limb_vector lsqr(const limb_vector &x);
+
+/**
+ * @brief Perform schoolbook limb squaring.
+ * @param res square of 2 * size limbs.
+ * @param x limbs to square.
+ * @param size number of limbs.
+ * @attention cross products are computed once and doubled,
+ * columns are carried as in mul_basecase.
+ */
+void sqr_basecase(limb *res, const limb *x, const size_t size) noexcept
+{
+    dlimb carry = 0;
+    for (size_t k = 0; k + 1 < 2 * size; ++k)
+    { // column k sums x[i] * x[k - i], cross products with i < k - i
+        const size_t first = k < size ? 0 : k - size + 1;
+        const size_t last = (k + 1) / 2;
+        dlimb acc = 0, high = 0;
+        for (size_t i = first; i < last;)
+        {
+            const size_t end = std::min(last, i + COMBA_BLOCK);
+            for (; i < end; ++i)
+                acc += static_cast<dlimb>(x[i]) * x[k - i];
+            high += acc / LIMB_BASE;
+            acc %= LIMB_BASE;
+        }
+        acc = 2 * acc + carry;
+        high *= 2;
+        if (k % 2 == 0)
+        {
+            const dlimb sqr = static_cast<dlimb>(x[k / 2]) * x[k / 2];
+            acc += sqr % LIMB_BASE;
+            high += sqr / LIMB_BASE;
+        }
+        res[k] = static_cast<limb>(acc % LIMB_BASE);
+        carry = high + acc / LIMB_BASE;
+    }
+    res[2 * size - 1] = static_cast<limb>(carry);
+}
+
+/**
+ * @brief Perform karatsuba limb multiplication.
+ * @param res product of x_size + y_size limbs.
+ * @param x multiplicand (x_size >= y_size > x_size / 2).
+ * @param y multiplier.
+ */
+void mul_karatsuba(limb *res, const limb *x, const size_t x_size,
+                   const limb *y, const size_t y_size)
+{
+    // x = x1 * B^m + x0, y = y1 * B^m + y0
+    const size_t m = x_size / 2;
+    const limb *x0 = x, *x1 = x + m;
+    const limb *y0 = y, *y1 = y + m;
+    const size_t x1_size = x_size - m, y1_size = y_size - m;
+
+    // z0 = x0 * y0 and z2 = x1 * y1 go straight into the result
+    mul_limbs(res, x0, m, y0, m);
+    mul_limbs(res + 2 * m, x1, x1_size, y1, y1_size);
+
+    // sx = x0 + x1, sy = y0 + y1
+    scratch_scope scratch;
+    limb *sx = scratch.alloc<limb>(x1_size + 1);
+    std::memcpy(sx, x1, x1_size * sizeof(limb));
+    sx[x1_size] = add_limbs(sx, x1_size, x0, m);
+    const size_t sy_len = std::max(y1_size, m) + 1;
+    limb *sy = scratch.alloc<limb>(sy_len);
+    if (y1_size >= m)
+    {
+        std::memcpy(sy, y1, y1_size * sizeof(limb));
+        sy[y1_size] = add_limbs(sy, y1_size, y0, m);
+    }
+    else
+    {
+        std::memcpy(sy, y0, m * sizeof(limb));
+        sy[m] = add_limbs(sy, m, y1, y1_size);
+    }
+    // z1 = sx * sy - z0 - z2
+    const size_t sx_size = trim_size(sx, x1_size + 1);
+    const size_t sy_size = trim_size(sy, sy_len);
+    const size_t z1_len = sx_size + sy_size + 1;
+    limb *z1 = scratch.alloc<limb>(z1_len);
+    std::memset(z1, 0, z1_len * sizeof(limb));
+    if (sx_size && sy_size)
+        mul_limbs(z1, sx, sx_size, sy, sy_size);
+    sub_limbs(z1, z1_len, res, trim_size(res, 2 * m));
+    sub_limbs(z1, z1_len, res + 2 * m,
+              trim_size(res + 2 * m, x1_size + y1_size));
+
+    add_limbs(res + m, x_size + y_size - m, z1, trim_size(z1, z1_len));
+}
+
+/**
+ * @brief Perform karatsuba limb squaring.
+ * @param res square of 2 * size limbs.
+ * @param x limbs to square.
+ * @param size number of limbs.
+ */
+void sqr_karatsuba(limb *res, const limb *x, const size_t size)
+{
+    // x = x1 * B^m + x0
+    const size_t m = size / 2, x1_size = size - m;
+    const limb *x0 = x, *x1 = x + m;
+
+    // z0 = x0^2 and z2 = x1^2 go straight into the result
+    sqr_limbs(res, x0, m);
+    sqr_limbs(res + 2 * m, x1, x1_size);
+
+    // z1 = (x0 + x1)^2 - z0 - z2
+    scratch_scope scratch;
+    limb *sx = scratch.alloc<limb>(x1_size + 1);
+    std::memcpy(sx, x1, x1_size * sizeof(limb));
+    sx[x1_size] = add_limbs(sx, x1_size, x0, m);
+    const size_t sx_size = trim_size(sx, x1_size + 1);
+    const size_t z1_len = 2 * sx_size + 1;
+    limb *z1 = scratch.alloc<limb>(z1_len);
+    std::memset(z1, 0, z1_len * sizeof(limb));
+    if (sx_size)
+        sqr_limbs(z1, sx, sx_size);
+    sub_limbs(z1, z1_len, res, trim_size(res, 2 * m));
+    sub_limbs(z1, z1_len, res + 2 * m,
+              trim_size(res + 2 * m, 2 * x1_size));
+
+    add_limbs(res + m, 2 * size - m, z1, trim_size(z1, z1_len));
+}
+
+/**
+ * @brief Split a limb range into three toom-3 pieces.
+ * @param x limbs to split as x2 * B^2k + x1 * B^k + x0.
+ * @param size number of limbs.
+ * @param k piece size.
+ * @param pieces receives x0, x1 and x2.
+ */
+void toom3_split(const limb *x, const size_t size, const size_t k,
+                 limb_vector (&pieces)[3])
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const size_t first = std::min(i * k, size);
+        const size_t last = (i == 2) ? size : std::min(first + k, size);
+        pieces[i].assign(x + first, x + last);
+        trim_limbs(pieces[i]);
+    }
+}
+
+/**
+ * @brief Evaluate toom-3 pieces at 1, -1 and -2.
+ * @param pieces x0, x1 and x2.
+ * @param p1 receives p(1) = x0 + x1 + x2.
+ * @param pm1 receives p(-1) = x0 - x1 + x2.
+ * @param pm2 receives p(-2) = 2 * (p(-1) + x2) - x0.
+ * @param pm1_sign receives the sign of p(-1).
+ * @param pm2_sign receives the sign of p(-2).
+ */
+void toom3_evaluate(const limb_vector (&pieces)[3],
+                    limb_vector &p1, limb_vector &pm1, limb_vector &pm2,
+                    bool &pm1_sign, bool &pm2_sign)
+{
+    p1 = pieces[0];
+    liadd(p1, pieces[2]);
+    pm1 = p1;
+    pm1_sign = signed_liadd(pm1, pieces[1], false, true);
+    liadd(p1, pieces[1]);
+    pm2 = pm1;
+    pm2_sign = signed_liadd(pm2, pieces[2], pm1_sign, false);
+    lmul_small(pm2, 2);
+    pm2_sign = signed_liadd(pm2, pieces[0], pm2_sign, true);
+}
+
+/**
+ * @brief Interpolate toom-3 point values and recompose the product.
+ * @param res product limbs.
+ * @param size number of product limbs.
+ * @param k piece size.
+ * @param r0 value at 0.
+ * @param r1 value at 1.
+ * @param rm1 value at -1.
+ * @param rm2 value at -2.
+ * @param rinf value at infinity.
+ * @param rm1_sign sign of the value at -1.
+ * @param rm2_sign sign of the value at -2.
+ * @attention follows bodrato's sequence, every division is exact.
+ */
+void toom3_interpolate(limb *res, const size_t size, const size_t k,
+                       const limb_vector &r0, limb_vector &r1,
+                       const limb_vector &rm1, const limb_vector &rm2,
+                       const limb_vector &rinf,
+                       const bool rm1_sign, const bool rm2_sign)
+{
+    limb_vector r3 = rm2;
+    bool r3_sign = signed_liadd(r3, r1, rm2_sign, true);
+    ldivexact_small(r3, 3); // r3 = (r(-2) - r(1)) / 3
+    bool r1_sign = signed_liadd(r1, rm1, false, !rm1_sign);
+    ldivexact_small(r1, 2); // r1 = (r(1) - r(-1)) / 2
+    limb_vector r2 = rm1;
+    bool r2_sign = signed_liadd(r2, r0, rm1_sign, true); // r2 = r(-1) - r0
+    limb_vector tmp = r2;
+    r3_sign = signed_liadd(tmp, r3, r2_sign, !r3_sign);
+    ldivexact_small(tmp, 2);
+    r3.swap(tmp);
+    limb_vector rinf2 = rinf;
+    lmul_small(rinf2, 2);
+    r3_sign = signed_liadd(r3, rinf2, r3_sign, false); // r3 = (r2 - r3) / 2 + 2 * rinf
+    r2_sign = signed_liadd(r2, r1, r2_sign, r1_sign);
+    r2_sign = signed_liadd(r2, rinf, r2_sign, true);   // r2 = r2 + r1 - rinf
+    r1_sign = signed_liadd(r1, r3, r1_sign, !r3_sign); // r1 = r1 - r3
+    assert(!r1_sign && !r2_sign && !r3_sign && "invalid interpolation");
+
+    // recompose the coefficients
+    std::memset(res, 0, size * sizeof(limb));
+    const limb_vector *coeffs[] = {&r0, &r1, &r2, &r3, &rinf};
+    for (size_t i = 0; i < 5; ++i)
+        add_limbs(res + i * k, size - i * k, coeffs[i]->data(), coeffs[i]->size());
+}
+
+/**
+ * @brief Perform toom-3 limb multiplication.
+ * @param res product of x_size + y_size limbs.
+ * @param x multiplicand (x_size >= y_size > 2 * ceil(x_size / 3)).
+ * @param y multiplier.
+ */
+void mul_toom3(limb *res, const limb *x, const size_t x_size,
+               const limb *y, const size_t y_size)
+{
+    // x = x2 * B^2k + x1 * B^k + x0, y = y2 * B^2k + y1 * B^k + y0
+    const size_t k = (x_size + 2) / 3;
+    limb_vector xs[3], ys[3];
+    toom3_split(x, x_size, k, xs);
+    toom3_split(y, y_size, k, ys);
+
+    limb_vector xp1, xm1, xm2, yp1, ym1, ym2;
+    bool xm1_sign, xm2_sign, ym1_sign, ym2_sign;
+    toom3_evaluate(xs, xp1, xm1, xm2, xm1_sign, xm2_sign);
+    toom3_evaluate(ys, yp1, ym1, ym2, ym1_sign, ym2_sign);
+
+    // pointwise products
+    const limb_vector r0 = lmul(xs[0], ys[0]);
+    limb_vector r1 = lmul(xp1, yp1);
+    const limb_vector rm1 = lmul(xm1, ym1);
+    const limb_vector rm2 = lmul(xm2, ym2);
+    const limb_vector rinf = lmul(xs[2], ys[2]);
+    const bool rm1_sign = !rm1.empty() && (xm1_sign ^ ym1_sign);
+    const bool rm2_sign = !rm2.empty() && (xm2_sign ^ ym2_sign);
+
+    toom3_interpolate(res, x_size + y_size, k, r0, r1, rm1, rm2, rinf,
+                      rm1_sign, rm2_sign);
+}
+
+/**
+ * @brief Perform toom-3 limb squaring.
+ * @param res square of 2 * size limbs.
+ * @param x limbs to square.
+ * @param size number of limbs.
+ */
+void sqr_toom3(limb *res, const limb *x, const size_t size)
+{
+    const size_t k = (size + 2) / 3;
+    limb_vector xs[3];
+    toom3_split(x, size, k, xs);
+
+    limb_vector xp1, xm1, xm2;
+    bool xm1_sign, xm2_sign;
+    toom3_evaluate(xs, xp1, xm1, xm2, xm1_sign, xm2_sign);
+
+    // pointwise squares are never negative
+    const limb_vector r0 = lsqr(xs[0]);
+    limb_vector r1 = lsqr(xp1);
+    const limb_vector rm1 = lsqr(xm1);
+    const limb_vector rm2 = lsqr(xm2);
+    const limb_vector rinf = lsqr(xs[2]);
+
+    toom3_interpolate(res, 2 * size, k, r0, r1, rm1, rm2, rinf, false, false);
+}
+
+/**
+ * @brief Calculate modular power.
+ * @param base number being raised.
+ * @param exp base raised to this power.
+ * @return base ** exp mod P.
+ */
+template <uint32_t P>
+uint32_t pow_mod(uint32_t base, uint64_t exp) noexcept
+{
+    uint64_t result = 1, b = base % P;
+    for (; exp; exp >>= 1, b = b * b % P)
+        if (exp & 1)
+            result = result * b % P;
+    return static_cast<uint32_t>(result);
+}
+
+/**
+ * @brief Perform inplace number theoretic transform modulo P.
+ * @param a values to transform, size must be a power of two.
+ * @param invert perform the inverse transform.
+ */
+template <uint32_t P>
+void ntt(std::vector<uint32_t> &a, const bool invert)
+{
+    const size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i)
+    { // bit reversal permutation
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+    std::vector<uint32_t> roots;
+    roots.reserve(n / 2);
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const size_t half = len / 2;
+        uint32_t w = pow_mod<P>(3, (P - 1) / len);
+        if (invert)
+            w = pow_mod<P>(w, P - 2);
+        roots.assign(1, 1);
+        for (size_t j = 1; j < half; ++j)
+            roots.push_back(static_cast<uint32_t>(
+                static_cast<uint64_t>(roots.back()) * w % P));
+
+        for (size_t i = 0; i < n; i += len)
+        {
+            uint32_t *lo = a.data() + i, *hi = lo + half;
+            for (size_t j = 0; j < half; ++j)
+            {
+                const uint32_t u = lo[j];
+                const uint32_t v = static_cast<uint32_t>(
+                    static_cast<uint64_t>(hi[j]) * roots[j] % P);
+                lo[j] = (u + v < P) ? u + v : u + v - P;
+                hi[j] = (u >= v) ? u - v : u + P - v;
+            }
+        }
+    }
+    if (!invert)
+        return;
+    const uint64_t n_inv = pow_mod<P>(static_cast<uint32_t>(n % P), P - 2);
+    for (size_t i = 0; i < n; ++i)
+        a[i] = static_cast<uint32_t>(a[i] * n_inv % P);
+}
+
+/**
+ * @brief Calculate the cyclic convolution of two limb ranges modulo P.
+ * @param x first operand.
+ * @param y second operand.
+ * @param size transform size (power of two >= x_size + y_size - 1).
+ * @return convolution residues.
+ */
+template <uint32_t P>
+std::vector<uint32_t> ntt_convolve(const limb *x, const size_t x_size,
+                                   const limb *y, const size_t y_size,
+                                   const size_t size)
+{
+    std::vector<uint32_t> fx(size, 0);
+    for (size_t i = 0; i < x_size; ++i)
+        fx[i] = x[i] % P;
+    ntt<P>(fx, false);
+    if (x == y && x_size == y_size)
+    { // squaring needs a single forward transform
+        for (size_t i = 0; i < size; ++i)
+            fx[i] = static_cast<uint32_t>(static_cast<uint64_t>(fx[i]) * fx[i] % P);
+        ntt<P>(fx, true);
+        return fx;
+    }
+    std::vector<uint32_t> fy(size, 0);
+    for (size_t i = 0; i < y_size; ++i)
+        fy[i] = y[i] % P;
+    ntt<P>(fy, false);
+    for (size_t i = 0; i < size; ++i)
+        fx[i] = static_cast<uint32_t>(static_cast<uint64_t>(fx[i]) * fy[i] % P);
+    ntt<P>(fx, true);
+    return fx;
+}
+
+/**
+ * @brief Perform limb multiplication with the number theoretic transform.
+ * @param res product of x_size + y_size limbs.
+ * @param x multiplicand (x_size + y_size <= NTT_MAX_SIZE).
+ * @param y multiplier.
+ * @attention convolutions are computed modulo three primes and
+ * reconstructed exactly with the chinese remainder theorem.
+ */
+void mul_ntt(limb *res, const limb *x, const size_t x_size,
+             const limb *y, const size_t y_size)
+{
+    const size_t conv_size = x_size + y_size - 1;
+    size_t size = 1;
+    while (size < conv_size)
+        size <<= 1;
+    const std::vector<uint32_t> c1 = ntt_convolve<NTT_P1>(x, x_size, y, y_size, size);
+    const std::vector<uint32_t> c2 = ntt_convolve<NTT_P2>(x, x_size, y, y_size, size);
+    const std::vector<uint32_t> c3 = ntt_convolve<NTT_P3>(x, x_size, y, y_size, size);
+
+    // garner's constants
+    const uint64_t p1_inv_p2 = pow_mod<NTT_P2>(NTT_P1, NTT_P2 - 2);
+    const uint64_t p1_inv_p3 = pow_mod<NTT_P3>(NTT_P1, NTT_P3 - 2);
+    const uint64_t p2_inv_p3 = pow_mod<NTT_P3>(NTT_P2, NTT_P3 - 2);
+    const uint64_t p12 = static_cast<uint64_t>(NTT_P1) * NTT_P2;
+    const uint64_t p12_lo = p12 % LIMB_BASE, p12_hi = p12 / LIMB_BASE;
+
+    // every coefficient is spread over three limbs before carrying
+    std::vector<dlimb> acc(x_size + y_size + 2, 0);
+    for (size_t i = 0; i < conv_size; ++i)
+    {
+        const uint64_t r1 = c1[i], r2 = c2[i], r3 = c3[i];
+        const uint64_t t1 = (r2 + NTT_P2 - r1 % NTT_P2) * p1_inv_p2 % NTT_P2;
+        uint64_t t2 = (r3 + NTT_P3 - r1 % NTT_P3) * p1_inv_p3 % NTT_P3;
+        t2 = (t2 + NTT_P3 - t1 % NTT_P3) * p2_inv_p3 % NTT_P3;
+        // value = r1 + p1 * t1 + p1 * p2 * t2
+        const uint64_t low = r1 + NTT_P1 * t1;
+        const uint64_t mid = t2 * p12_lo, high = t2 * p12_hi;
+        acc[i] += low % LIMB_BASE + mid % LIMB_BASE;
+        acc[i + 1] += low / LIMB_BASE + mid / LIMB_BASE + high % LIMB_BASE;
+        acc[i + 2] += high / LIMB_BASE;
+    }
+    dlimb carry = 0;
+    for (size_t i = 0; i < x_size + y_size; ++i)
+    {
+        carry += acc[i];
+        res[i] = static_cast<limb>(carry % LIMB_BASE);
+        carry /= LIMB_BASE;
+    }
+}
+
+/**
+ * @brief Perform limb multiplication selecting the algorithm by size.
+ * @param res product of x_size + y_size limbs.
+ * @param x multiplicand.
+ * @param y multiplier.
+ */
+void mul_limbs(limb *res, const limb *x, size_t x_size,
+               const limb *y, size_t y_size)
+{
+    if (x == y && x_size == y_size)
+        return sqr_limbs(res, x, x_size);
+    if (x_size < y_size)
+    {
+        std::swap(x, y);
+        std::swap(x_size, y_size);
+    }
+    if (y_size < KARATSUBA_THRESHOLD)
+        return mul_basecase(res, x, x_size, y, y_size);
+
+    if (y_size >= NTT_THRESHOLD && x_size + y_size <= NTT_MAX_SIZE)
+        return mul_ntt(res, x, x_size, y, y_size);
+
+    if (2 * y_size <= x_size)
+    { // unbalanced, multiply y by x in y_size chunks
+        std::memset(res, 0, (x_size + y_size) * sizeof(limb));
+        scratch_scope scratch;
+        limb *prod = scratch.alloc<limb>(2 * y_size);
+        for (size_t i = 0; i < x_size; i += y_size)
+        {
+            const size_t chunk = std::min(y_size, x_size - i);
+            mul_limbs(prod, x + i, chunk, y, y_size);
+            add_limbs(res + i, x_size + y_size - i, prod, chunk + y_size);
+        }
+        return;
+    }
+    if (y_size < TOOM3_THRESHOLD || y_size <= 2 * ((x_size + 2) / 3))
+        return mul_karatsuba(res, x, x_size, y, y_size);
+    mul_toom3(res, x, x_size, y, y_size);
+}
+
+/**
+ * @brief Perform limb squaring selecting the algorithm by size.
+ * @param res square of 2 * size limbs.
+ * @param x limbs to square.
+ * @param size number of limbs.
+ */
+void sqr_limbs(limb *res, const limb *x, const size_t size)
+{
+    if (size < KARATSUBA_THRESHOLD)
+        return sqr_basecase(res, x, size);
+    if (size >= NTT_THRESHOLD && 2 * size <= NTT_MAX_SIZE)
+        return mul_ntt(res, x, size, x, size);
+    if (size < TOOM3_THRESHOLD)
+        return sqr_karatsuba(res, x, size);
+    sqr_toom3(res, x, size);
+}
+
+/**
+ * @brief Perform limb multiplication.
+ * @param x multiplicand.
+ * @param y multiplier.
+ * @param * vector of limbs.
+ * @return product of the multiplicand and multiplier.
+ */
+const limb_vector lmul(const limb_vector &x, const limb_vector &y)
+{
+    if (x.empty() || y.empty())
+        return {};
+    limb_vector result(x.size() + y.size());
+    mul_limbs(result.data(), x.data(), x.size(), y.data(), y.size());
+    trim_limbs(result);
+    return result;
+}
+
+/**
+ * @brief Perform limb squaring.
+ * @param x limbs to square.
+ * @param * vector of limbs.
+ * @return x * x.
+ */
+const limb_vector lsqr(const limb_vector &x)
+{
+    if (x.empty())
+        return {};
+    limb_vector result(2 * x.size());
+    sqr_limbs(result.data(), x.data(), x.size());
+    trim_limbs(result);
+    return result;
+}
+
+/**
+ * @brief Perform limb division by a single limb.
+ * @param x dividend.
+ * @param y divisor (non zero).
+ * @param rem receives the remainder.
+ * @param * vector of limbs.
+ * @return quotient.
+ */
+const limb_vector ldivmod_small(const limb_vector &x, const limb y, limb &rem) noexcept
+{
+    limb_vector quot(x.size());
+    dlimb r = 0;
+    for (size_t i = x.size(); i > 0; --i)
+    {
+        const dlimb cur = r * LIMB_BASE + x[i - 1];
+        quot[i - 1] = static_cast<limb>(cur / y);
+        r = cur % y;
+    }
+    trim_limbs(quot);
+    rem = static_cast<limb>(r);
+    return quot;
+}
+
+/**
+ * @brief Get the binary digits of limbs.
+ * @param x vector of limbs.
+ * @return bits of x, least significant first.
+ */
+std::vector<bool> lbits(limb_vector x)
+{
+    constexpr size_t chunk_bits = 29U; // 2^29 < LIMB_BASE
+    std::vector<bool> bits;
+    while (!x.empty())
+    {
+        limb chunk;
+        x = ldivmod_small(x, static_cast<limb>(1) << chunk_bits, chunk);
+        for (size_t i = 0; i < chunk_bits; ++i)
+            bits.push_back((chunk >> i) & 1);
+    }
+    while (!bits.empty() && !bits.back())
+        bits.pop_back();
+    return bits;
+}
+
+/**
+ * @brief Calculate the limb power by binary exponentiation.
+ * @param base number being raised.
+ * @param exp base raised to this power.
+ * @param * vector of limbs.
+ * @return base ** exp.
+ */
+const limb_vector lpow(const limb_vector &base, const limb_vector &exp)
+{
+    const std::vector<bool> bits = lbits(exp);
+    limb_vector result(1, 1);
+    for (size_t i = bits.size(); i-- > 0;)
+    {
+        limb_vector prod = lsqr(result);
+        if (bits[i])
+            prod = lmul(prod, base);
+        result.swap(prod);
+    }
+    return result;
+}
+
+/**
+ * @brief Multiply limbs by a power of ten.
+ * @param x vector of limbs to modify.
+ * @param exp power of ten.
+ */
+void lmul_pow10(limb_vector &x, const size_t exp)
+{
+    if (x.empty())
+        return;
+    limb scale = 1;
+    for (size_t i = 0; i < exp % LIMB_DIGITS; ++i)
+        scale *= 10;
+    lmul_small(x, scale);
+    x.insert(x.begin(), exp / LIMB_DIGITS, 0);
+}
+
+/**
+ * @brief Get the limbs below a limb position.
+ * @param x vector of limbs.
+ * @param pos limb position.
+ * @return x mod B^pos.
+ */
+inline limb_vector low_limbs(const limb_vector &x, const size_t pos)
+{
+    limb_vector result(x.begin(), x.begin() + std::min(pos, x.size()));
+    trim_limbs(result);
+    return result;
+}
+
+/**
+ * @brief Get the limbs from a limb position.
+ * @param x vector of limbs.
+ * @param pos limb position.
+ * @return x / B^pos.
+ */
+inline limb_vector high_limbs(const limb_vector &x, const size_t pos)
+{
+    if (pos >= x.size())
+        return {};
+    return limb_vector(x.begin() + pos, x.end());
+}
+
+/**
+ * @brief Combine limbs as high * B^pos + low.
+ * @param high limbs above the position.
+ * @param low limbs below the position (at most pos limbs).
+ * @param pos limb position.
+ */
+inline limb_vector join_limbs(const limb_vector &high,
+                                    const limb_vector &low, const size_t pos)
+{
+    if (high.empty())
+        return low;
+    limb_vector result(low);
+    result.resize(pos, 0);
+    result.insert(result.end(), high.begin(), high.end());
+    return result;
+}
+
+/**
+ * @brief Count the decimal digits of limbs.
+ * @param x vector of limbs.
+ * @return number of digits, 0 if x is zero.
+ */
+inline size_t ldigits(const limb_vector &x) noexcept
+{
+    if (x.empty())
+        return 0;
+    size_t size = (x.size() - 1) * LIMB_DIGITS + 1;
+    for (limb top = x.back(); top >= 10; top /= 10)
+        ++size;
+    return size;
+}
+
+/**
+ * @brief Get a decimal digit of limbs.
+ * @param x vector of limbs.
+ * @param pos digit position, 0 is the least significant digit.
+ * @return digit at pos, 0 above the most significant digit.
+ */
+inline udigit ldigit(const limb_vector &x, const size_t pos) noexcept
+{
+    if (pos / LIMB_DIGITS >= x.size())
+        return 0;
+    limb value = x[pos / LIMB_DIGITS];
+    for (size_t i = pos % LIMB_DIGITS; i > 0; --i)
+        value /= 10;
+    return static_cast<udigit>(value % 10);
+}
+
+/**
+ * @brief Count the trailing zero digits of limbs.
+ * @param x vector of limbs.
+ * @return number of zero digits below the lowest non zero digit,
+ * 0 if x is zero.
+ */
+inline size_t lzeros(const limb_vector &x) noexcept
+{
+    size_t i = 0;
+    while (i < x.size() && x[i] == 0)
+        ++i;
+    if (i == x.size())
+        return 0;
+    size_t zeros = i * LIMB_DIGITS;
+    for (limb low = x[i]; low % 10 == 0; low /= 10)
+        ++zeros;
+    return zeros;
+}
+
+/**
+ * @brief Split limbs at a decimal digit.
+ * @param x vector of limbs.
+ * @param digits number of low decimal digits.
+ * @param high receives x / 10^digits.
+ * @param low receives x mod 10^digits.
+ */
+void lsplit(const limb_vector &x, const size_t digits,
+            limb_vector &high, limb_vector &low)
+{
+    const size_t pos = digits / LIMB_DIGITS;
+    low = low_limbs(x, pos);
+    high = high_limbs(x, pos);
+    if (digits % LIMB_DIGITS)
+    { // split the partial limb
+        limb scale = 1, part;
+        for (size_t i = 0; i < digits % LIMB_DIGITS; ++i)
+            scale *= 10;
+        high = ldivmod_small(high, scale, part);
+        if (part)
+            low = join_limbs({part}, low, pos);
+    }
+}
+
+/**
+ * @brief Discard low decimal digits with rounding.
+ * @param x vector of limbs to modify.
+ * @param digits number of decimal digits to discard.
+ * @param mode rounding mode.
+ * @param sign sign of the number.
+ */
+void lround(limb_vector &x, const size_t digits,
+            const rounding mode, const bool sign)
+{
+    if (digits == 0 || x.empty())
+        return;
+    const size_t pos = digits / LIMB_DIGITS;
+    limb_vector rem = low_limbs(x, pos);
+    x = high_limbs(x, pos);
+    if (digits % LIMB_DIGITS)
+    { // split the partial limb
+        limb scale = 1, low;
+        for (size_t i = 0; i < digits % LIMB_DIGITS; ++i)
+            scale *= 10;
+        x = ldivmod_small(x, scale, low);
+        if (low)
+            rem = join_limbs({low}, rem, pos);
+    }
+    if (rem.empty()) // nothing discarded
+        return;
+
+    // compare the discarded part with half a unit: 2 * rem <=> 10^digits
+    limb_vector unit(1, 1);
+    lmul_pow10(unit, digits);
+    lmul_small(rem, 2);
+    const short half = lcmp(rem, unit);
+    const bool odd = !x.empty() && (x[0] & 1);
+    if (round_away(mode, sign, true, half, odd))
+        liadd(x, {1});
+}
+
+/**
+ * @brief Discard low decimal digits towards zero.
+ * @param x vector of limbs to modify.
+ * @param digits number of decimal digits to discard.
+ * @return true if a discarded digit was non zero.
+ */
+bool ltruncate(limb_vector &x, const size_t digits)
+{
+    if (digits == 0 || x.empty())
+        return false;
+    const size_t pos = digits / LIMB_DIGITS;
+    bool inexact = false;
+    for (size_t i = 0; i < pos && i < x.size(); ++i)
+        inexact = inexact || x[i] != 0;
+    x = high_limbs(x, pos);
+    if (digits % LIMB_DIGITS)
+    { // split the partial limb
+        limb scale = 1, low;
+        for (size_t i = 0; i < digits % LIMB_DIGITS; ++i)
+            scale *= 10;
+        x = ldivmod_small(x, scale, low);
+        inexact = inexact || low != 0;
+    }
+    return inexact;
+}
+
+/**
+ * @brief Round off the guard limb of a truncated approximation.
+ * @param x approximation carrying LIMB_DIGITS guard digits, at most
+ * two guard units below the exact value and never above it.
+ * @param mode rounding mode.
+ * @param sign sign of the number.
+ * @return false if x is left unchanged because the guard digits are
+ * too close to a rounding boundary to decide the direction.
+ */
+bool lround_guard(limb_vector &x, const rounding mode, const bool sign)
+{
+    const limb guard = x.empty() ? 0 : x[0];
+    constexpr limb half = LIMB_BASE / 2;
+    if (guard == 0 || guard == half - 1 || guard == half || guard == LIMB_BASE - 1)
+        return false;
+    x = high_limbs(x, 1);
+    const bool odd = !x.empty() && (x[0] & 1);
+    if (round_away(mode, sign, true, guard > half ? 1 : -1, odd))
+        liadd(x, {1});
+    return true;
+}
+
+/**
+ * @brief Convert binary words to limbs by divide and conquer.
+ * @param x binary words, least significant first.
+ * @param size number of words.
+ * @param powers powers[i] = 2^(32 * 2^i) as limbs.
+ * @return value of the words as limbs.
+ */
+limb_vector binary_limbs(const uint32_t *x, const size_t size,
+                               std::vector<limb_vector> &powers)
+{
+    if (size <= 8)
+    { // horner's rule, one word is two 16 bit steps
+        limb_vector result;
+        for (size_t i = size; i > 0; --i)
+        {
+            lmul_small(result, 1U << 16);
+            lmul_small(result, 1U << 16);
+            liadd(result, {x[i - 1] % LIMB_BASE, x[i - 1] / LIMB_BASE});
+            trim_limbs(result);
+        }
+        return result;
+    }
+    size_t level = 0; // split at the largest power of two below size
+    while ((static_cast<size_t>(2) << level) < size)
+        ++level;
+    const size_t half = static_cast<size_t>(1) << level;
+    while (powers.size() <= level)
+        powers.push_back(lsqr(powers.back()));
+    limb_vector result = lmul(binary_limbs(x + half, size - half, powers), powers[level]);
+    liadd(result, binary_limbs(x, half, powers));
+    return result;
+}
+
+/**
+ * @brief Convert binary words to limbs.
+ * @param x binary words, least significant first.
+ * @return value of the words as limbs.
+ */
+limb_vector from_binary(const std::vector<uint32_t> &x)
+{
+    std::vector<limb_vector> powers(1);
+    powers[0] = {1};
+    lmul_small(powers[0], 1U << 16);
+    lmul_small(powers[0], 1U << 16);
+    return binary_limbs(x.data(), x.size(), powers);
+}
+
+/**
+ * @brief Perform limb long division (knuth's algorithm d).
+ * @param x dividend.
+ * @param y divisor (non zero).
+ * @param * vector of limbs.
+ * @return quotient and remainder.
+ */
+const std::pair<limb_vector, limb_vector>
+div_basecase(const limb_vector &x, const limb_vector &y)
+{
+    if (lcmp(x, y) < 0)
+        return {{}, x};
+    if (y.size() == 1)
+    {
+        limb rem;
+        limb_vector quot = ldivmod_small(x, y.front(), rem);
+        return {quot, rem ? limb_vector(1, rem) : limb_vector()};
+    }
+    const size_t n = y.size(), m = x.size() - n;
+    // normalize so the divisor's top limb is at least LIMB_BASE / 2
+    const limb scale = static_cast<limb>(LIMB_BASE / (static_cast<dlimb>(y.back()) + 1));
+    limb_vector u = x, v = y;
+    lmul_small(u, scale);
+    lmul_small(v, scale);
+    u.resize(x.size() + 1, 0);
+
+    const dlimb v1 = v[n - 1], v2 = v[n - 2];
+    limb_vector quot(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0;)
+    {
+        // estimate the quotient limb from the top two limbs
+        const dlimb num = static_cast<dlimb>(u[j + n]) * LIMB_BASE + u[j + n - 1];
+        dlimb qhat = num / v1, rhat = num % v1;
+        while (qhat >= LIMB_BASE || qhat * v2 > rhat * LIMB_BASE + u[j + n - 2])
+        {
+            --qhat;
+            rhat += v1;
+            if (rhat >= LIMB_BASE)
+                break;
+        }
+        // multiply and subtract
+        dlimb carry = 0;
+        int64_t borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const dlimb prod = qhat * v[i] + carry;
+            carry = prod / LIMB_BASE;
+            const int64_t res = static_cast<int64_t>(u[i + j]) -
+                                static_cast<int64_t>(prod % LIMB_BASE) - borrow;
+            borrow = res < 0;
+            u[i + j] = static_cast<limb>(borrow ? res + LIMB_BASE : res);
+        }
+        const int64_t top = static_cast<int64_t>(u[j + n]) -
+                            static_cast<int64_t>(carry) - borrow;
+        if (top < 0)
+        { // estimate was one too large, add back
+            u[j + n] = static_cast<limb>(top + LIMB_BASE);
+            --qhat;
+            add_limbs(u.data() + j, n + 1, v.data(), n);
+            u[j + n] = 0; // carry out cancels the borrow
+        }
+        else
+            u[j + n] = static_cast<limb>(top);
+        quot[j] = static_cast<limb>(qhat);
+    }
+    trim_limbs(quot);
+    u.resize(n);
+    trim_limbs(u);
+    limb rem;
+    return {quot, ldivmod_small(u, scale, rem)}; // undo normalization
+}
+
+const std::pair<limb_vector, limb_vector>
+div_3n_2n(const limb_vector &x, const limb_vector &y, const size_t n);
+
+/**
+ * @brief Perform recursive 2n by n limb division.
+ * @param x dividend (x < y * B^n).
+ * @param y normalized divisor of n limbs.
+ * @param n divisor size.
+ * @return quotient and remainder.
+ */
+const std::pair<limb_vector, limb_vector>
+div_2n_1n(const limb_vector &x, const limb_vector &y, const size_t n)
+{
+    if (n % 2 || n < BZ_THRESHOLD)
+        return div_basecase(x, y);
+
+    const size_t half = n / 2;
+    std::pair<limb_vector, limb_vector> q1, q2;
+    q1 = div_3n_2n(high_limbs(x, half), y, half);
+    q2 = div_3n_2n(join_limbs(q1.second, low_limbs(x, half), half), y, half);
+    return {join_limbs(q1.first, q2.first, half), q2.second};
+}
+
+/**
+ * @brief Perform recursive 3n by 2n limb division.
+ * @param x dividend (x < y * B^n).
+ * @param y normalized divisor of 2n limbs.
+ * @param n half of the divisor size.
+ * @return quotient and remainder.
+ */
+const std::pair<limb_vector, limb_vector>
+div_3n_2n(const limb_vector &x, const limb_vector &y, const size_t n)
+{
+    // y = y1 * B^n + y2
+    const limb_vector y1 = high_limbs(y, n);
+    const limb_vector y2 = low_limbs(y, n);
+    const limb_vector x12 = high_limbs(x, n);
+
+    std::pair<limb_vector, limb_vector> div;
+    if (lcmp(high_limbs(x, 2 * n), y1) < 0)
+        div = div_2n_1n(x12, y1, n);
+    else
+    { // quotient is B^n - 1, remainder is x12 - y1 * B^n + y1
+        div.first.assign(n, LIMB_BASE - 1);
+        div.second = x12;
+        liadd(div.second, y1);
+        limb_vector shifted = join_limbs(y1, {}, n);
+        lisub(div.second, shifted);
+    }
+    // remainder = (r * B^n + x3) - q * y2, at most two corrections
+    limb_vector rem = join_limbs(div.second, low_limbs(x, n), n);
+    const limb_vector prod = lmul(div.first, y2);
+    while (lcmp(rem, prod) < 0)
+    {
+        limb_vector one(1, 1);
+        lisub(div.first, one);
+        liadd(rem, y);
+    }
+    lisub(rem, prod);
+    return {div.first, rem};
+}
+
+/**
+ * @brief Perform burnikel-ziegler limb division.
+ * @param x dividend.
+ * @param y divisor (non zero).
+ * @param * vector of limbs.
+ * @return quotient and remainder.
+ */
+const std::pair<limb_vector, limb_vector>
+div_burnikel(const limb_vector &x, const limb_vector &y)
+{
+    // pad the divisor to n = j * 2^k limbs with j below the threshold
+    const size_t y_size = y.size();
+    size_t m = 1;
+    while (BZ_THRESHOLD * m < y_size)
+        m <<= 1;
+    const size_t j = (y_size + m - 1) / m, n = j * m;
+    const size_t shift = n - y_size;
+
+    // normalize so the divisor's top limb is at least LIMB_BASE / 2
+    const limb scale = static_cast<limb>(LIMB_BASE / (static_cast<dlimb>(y.back()) + 1));
+    limb_vector a = x, b = y;
+    lmul_small(a, scale);
+    lmul_small(b, scale);
+    a.insert(a.begin(), shift, 0);
+    b.insert(b.begin(), shift, 0);
+
+    // divide n limb blocks from the top, the top block stays below b
+    const size_t blocks = std::max<size_t>(2, (a.size() + n) / n);
+    a.resize(blocks * n, 0);
+    limb_vector quot(a.size() - n, 0);
+    limb_vector rem(a.end() - n, a.end());
+    trim_limbs(rem);
+    for (size_t i = blocks - 1; i-- > 0;)
+    {
+        limb_vector block(a.begin() + i * n, a.begin() + (i + 1) * n);
+        trim_limbs(block);
+        std::pair<limb_vector, limb_vector> div;
+        div = div_2n_1n(join_limbs(rem, block, n), b, n);
+        std::copy(div.first.begin(), div.first.end(), quot.begin() + i * n);
+        rem.swap(div.second);
+    }
+    trim_limbs(quot);
+    rem = high_limbs(rem, shift);
+    limb r;
+    return {quot, ldivmod_small(rem, scale, r)}; // undo normalization
+}
+
+/**
+ * @brief Perform limb division selecting the algorithm by size.
+ * @param x dividend.
+ * @param y divisor.
+ * @param * vector of limbs.
+ * @return quotient and remainder.
+ * @throw std::domain_error if division by zero.
+ */
+const std::pair<limb_vector, limb_vector>
+ldivmod(const limb_vector &x, const limb_vector &y)
+{
+    if (y.empty())
+        throw std::domain_error("division by zero");
+    if (y.size() < BZ_THRESHOLD || x.size() < y.size() + BZ_THRESHOLD)
+        return div_basecase(x, y);
+    return div_burnikel(x, y);
+}
+
+const std::pair<limb_vector, limb_vector> lsqrtrem(const limb_vector &x);
+
+/**
+ * @brief Calculate the integer n-th root by newton iteration.
+ * @param x radicand.
+ * @param n degree of the root (0 < n < LIMB_BASE).
+ * @param * vector of limbs.
+ * @return floor(x ** (1 / n)).
+ * @attention the starting guess is the root of the leading limbs, so
+ * each recursion level doubles the precision of the previous one.
+ * Square roots above four limbs are taken by lsqrtrem instead.
+ */
+const limb_vector lroot(const limb_vector &x, const limb n)
+{
+    if (x.empty() || n == 1)
+        return x;
+    if (n == 2 && x.size() > 4)
+        return lsqrtrem(x).first;
+    const size_t shift = x.size() / n / 2; // low limbs left to newton
+    limb_vector guess;
+    if (shift == 0)
+    { // guess 10^ceil(digits / n) is above the root
+        size_t digits = (x.size() - 1) * LIMB_DIGITS;
+        for (limb top = x.back(); top; top /= 10)
+            ++digits;
+        guess.assign(1, 1);
+        lmul_pow10(guess, (digits + n - 1) / n);
+    }
+    else
+    { // (root of leading limbs + 1) * B^shift is above the root
+        guess = lroot(high_limbs(x, n * shift), n);
+        liadd(guess, {1});
+        guess.insert(guess.begin(), shift, 0);
+    }
+    const limb_vector degree(1, n - 1), exp(1, n);
+    while (true)
+    { // next = ((n - 1) * guess + x / guess^(n - 1)) / n
+        limb_vector next = ldivmod(x, n == 2 ? guess : lpow(guess, degree)).first;
+        limb_vector prod = guess;
+        lmul_small(prod, n - 1);
+        liadd(next, prod);
+        limb rem;
+        next = ldivmod_small(next, n, rem);
+        if (lcmp(next, guess) >= 0) // iterates decrease until the root
+            return guess;
+        // iterates never fall below the root, so next^n <= x ends the search
+        // with a power instead of another division
+        if (lcmp(n == 2 ? lsqr(next) : lpow(next, exp), x) <= 0)
+            return next;
+        guess.swap(next);
+    }
+}
+
+/**
+ * @brief Calculate the integer square root and its remainder.
+ * @param x radicand.
+ * @param * vector of limbs.
+ * @return floor(sqrt(x)) and x - floor(sqrt(x))^2.
+ * @attention karatsuba square root (Zimmermann): the root of the leading
+ * limbs is extended by dividing by twice itself, so the working size
+ * doubles each level and the top level costs one half size division
+ * and one half size squaring instead of full size newton steps.
+ */
+const std::pair<limb_vector, limb_vector> lsqrtrem(const limb_vector &x)
+{
+    const size_t k = x.empty() ? 0 : (x.size() - 1) / 4;
+    if (k == 0)
+    { // at most four limbs
+        limb_vector root = lroot(x, 2), rem(x);
+        lisub(rem, lsqr(root));
+        return {root, rem};
+    }
+    // x = a3 * B^3k + a2 * B^2k + a1 * B^k + a0, a3 has more than k limbs
+    const limb_vector a0 = low_limbs(x, k);
+    const limb_vector a1 = low_limbs(high_limbs(x, k), k);
+    std::pair<limb_vector, limb_vector> top = lsqrtrem(high_limbs(x, 2 * k));
+
+    // q, u = divmod(r' * B^k + a1, 2 * s')
+    limb_vector twice = top.first;
+    lmul_small(twice, 2);
+    std::pair<limb_vector, limb_vector> div =
+        ldivmod(join_limbs(top.second, a1, k), twice);
+
+    // s = s' * B^k + q, r = u * B^k + a0 - q^2
+    limb_vector root = join_limbs(top.first, limb_vector(), k);
+    liadd(root, div.first);
+    limb_vector rem = join_limbs(div.second, a0, k);
+    const limb_vector square = lsqr(div.first);
+    if (lcmp(rem, square) < 0)
+    { // one too large, r += 2 * s - 1 and s -= 1
+        limb_vector twice_root = root;
+        lmul_small(twice_root, 2);
+        liadd(rem, twice_root);
+        lisub(rem, {1});
+        lisub(root, {1});
+    }
+    lisub(rem, square);
+    return {root, rem};
+}
+
+/**
+ * @brief Compute the barrett reciprocal of a modulus.
+ * @param m modulus (non zero).
+ * @param * vector of limbs.
+ * @return floor(B^(2 * size) / m).
+ */
+const limb_vector barrett_reciprocal(const limb_vector &m)
+{
+    limb_vector power(2 * m.size() + 1, 0);
+    power.back() = 1;
+    return ldivmod(power, m).first;
+}
+
+/**
+ * @brief Divide limbs by m using a precomputed reciprocal.
+ * @param x dividend (x < B^(2 * size of m)).
+ * @param m divisor.
+ * @param mu barrett reciprocal of m.
+ * @param * vector of limbs.
+ * @return quotient and remainder.
+ */
+const std::pair<limb_vector, limb_vector>
+barrett_divmod(const limb_vector &x, const limb_vector &m, const limb_vector &mu)
+{
+    if (lcmp(x, m) < 0)
+        return {limb_vector(), x};
+    const size_t k = m.size();
+    // estimate the quotient, it is at most two below the exact one
+    limb_vector quot = high_limbs(lmul(high_limbs(x, k - 1), mu), k + 1);
+    limb_vector rem(x);
+    lisub(rem, lmul(quot, m));
+    while (lcmp(rem, m) >= 0)
+    {
+        lisub(rem, m);
+        liadd(quot, {1});
+    }
+    return {std::move(quot), std::move(rem)};
+}
+
+/**
+ * @brief Reduce limbs modulo m using a precomputed reciprocal.
+ * @param x number to reduce (x < B^(2 * size of m)).
+ * @param m modulus.
+ * @param mu barrett reciprocal of m.
+ * @param * vector of limbs.
+ * @return x mod m.
+ */
+inline const limb_vector barrett_reduce(const limb_vector &x,
+                                        const limb_vector &m,
+                                        const limb_vector &mu)
+{
+    return barrett_divmod(x, m, mu).second;
+}
+
+/**
+ * @brief Divide limbs of any size by m using a precomputed reciprocal.
+ * @param x dividend.
+ * @param m divisor.
+ * @param mu barrett reciprocal of m.
+ * @param * vector of limbs.
+ * @return quotient and remainder.
+ * @attention long dividends are divided in steps of m.size() limbs,
+ * each step divides a number below B^(2 * size of m). Below
+ * BARRETT_THRESHOLD limbs the steps cost more than schoolbook division.
+ */
+const std::pair<limb_vector, limb_vector>
+barrett_ldivmod(const limb_vector &x, const limb_vector &m, const limb_vector &mu)
+{
+    const size_t k = m.size();
+    if (x.size() <= 2 * k)
+        return barrett_divmod(x, m, mu);
+    if (k < BARRETT_THRESHOLD)
+        return ldivmod(x, m);
+    const size_t steps = (x.size() + k - 1) / k;
+    limb_vector quot(steps * k, 0), rem;
+    for (size_t i = steps; i > 0; --i)
+    { // bring down the next k limbs
+        const size_t pos = (i - 1) * k;
+        limb_vector part(x.begin() + pos, x.begin() + std::min(pos + k, x.size()));
+        trim_limbs(part);
+        std::pair<limb_vector, limb_vector> step =
+            barrett_divmod(join_limbs(rem, part, k), m, mu);
+        std::copy(step.first.begin(), step.first.end(), quot.begin() + pos);
+        rem.swap(step.second);
+    }
+    trim_limbs(quot);
+    return {std::move(quot), std::move(rem)};
+}
+
+/**
+ * @brief Calculate the modular power by sliding window exponentiation.
+ * @param base number being raised.
+ * @param exp base raised to this power.
+ * @param mod modulus (non zero).
+ * @param * vector of limbs.
+ * @return base ** exp mod mod.
+ */
+const limb_vector lpowmod(const limb_vector &base,
+                                const limb_vector &exp,
+                                const limb_vector &mod)
+{
+    if (mod.size() == 1 && mod[0] == 1)
+        return {};
+    const std::vector<bool> bits = lbits(exp);
+    if (bits.empty())
+        return {1};
+
+    const limb_vector mu = barrett_reciprocal(mod);
+    const limb_vector b = ldivmod(base, mod).second;
+    const size_t n = bits.size();
+    const size_t width = n > 671 ? 6 : n > 239 ? 5 : n > 79 ? 4 : n > 23 ? 3 : n > 6 ? 2 : 1;
+
+    // odd powers b, b^3, ..., b^(2^width - 1)
+    std::vector<limb_vector> table(static_cast<size_t>(1) << (width - 1));
+    table[0] = b;
+    if (table.size() > 1)
+    {
+        const limb_vector b2 = barrett_reduce(lsqr(b), mod, mu);
+        for (size_t i = 1; i < table.size(); ++i)
+            table[i] = barrett_reduce(lmul(table[i - 1], b2), mod, mu);
+    }
+
+    limb_vector result;
+    bool started = false;
+    for (size_t i = n; i > 0;)
+    {
+        if (!bits[i - 1])
+        { // square through zero bits
+            if (started)
+                result = barrett_reduce(lsqr(result), mod, mu);
+            --i;
+            continue;
+        }
+        // longest window ending in a set bit
+        size_t j = i > width ? i - width : 0;
+        while (!bits[j])
+            ++j;
+        size_t window = 0;
+        for (size_t k = i; k > j; --k)
+            window = (window << 1) | bits[k - 1];
+        if (started)
+        {
+            for (size_t k = j; k < i; ++k)
+                result = barrett_reduce(lsqr(result), mod, mu);
+            result = barrett_reduce(lmul(result, table[window >> 1]), mod, mu);
+        }
+        else
+            result = table[window >> 1];
+        started = true;
+        i = j;
+    }
+    return result;
+}
+
+/**
+ * @brief Calculate the modular inverse by the extended euclidean algorithm.
+ * @param x number to invert.
+ * @param mod modulus (non zero).
+ * @param * vector of limbs.
+ * @return y with x * y = 1 mod mod.
+ * @throw std::invalid_argument if x is not invertible.
+ */
+const limb_vector linvmod(const limb_vector &x, const limb_vector &mod)
+{
+    limb_vector r0 = mod, r1 = ldivmod(x, mod).second;
+    limb_vector t0, t1(1, 1);
+    bool s0 = false, s1 = false;
+    while (!r1.empty())
+    {
+        std::pair<limb_vector, limb_vector> div = ldivmod(r0, r1);
+        r0.swap(r1);
+        r1.swap(div.second);
+        // t0 - quot * t1
+        const bool sign = signed_liadd(t0, lmul(div.first, t1), s0, !s1);
+        t0.swap(t1);
+        s0 = s1;
+        s1 = sign;
+    }
+    if (!(r0.size() == 1 && r0[0] == 1))
+        throw std::invalid_argument("base is not invertible for the given modulus");
+    if (!s0 || t0.empty())
+        return t0;
+    limb_vector inv = mod;
+    lisub(inv, t0);
+    return inv;
+}
+
+#endif // LMATH_H
@@ -0,0 +1,230 @@
+#ifndef MEXPR_H
+#define MEXPR_H
+#include <type_traits>
+#include "mnum.h"
+
+/*
+ * Opt-in expression templates for mnum.
+ *
+ * Wrapping an operand with lazy() makes +, - and * build an expression
+ * tree instead of mnum temporaries:
+ *
+ *     mnum r = lazy(a) * b + lazy(c) * d - e;
+ *
+ * The tree is evaluated in one pass over fixed point base 10^9 limbs and
+ * the digits are unpacked once, into the destination. Multiply-add,
+ * multiply-subtract and sums of products therefore never materialize
+ * their intermediates, and the result is rounded once to the context
+ * max_fraction (like a fused multiply-add) instead of after every step.
+ * Leaves are held by reference, evaluate an expression before its
+ * operands go out of scope.
+ */
+
+/**
+ * @brief Exact fixed point value of a subexpression.
+ */
+struct fixed_limbs
+{
+    limb_vector mag; // magnitude * 10^frac
+    size_t frac;     // number of fraction digits
+    bool sign;
+};
+
+/**
+ * @brief Pack a number into fixed point limbs.
+ * @param x number to pack.
+ * @return value of x as fixed point limbs.
+ */
+inline fixed_limbs pack_fixed(const mnum &x)
+{
+    return {x.mag, x.frac, x.sign};
+}
+
+/**
+ * @brief Perform inplace fixed point addition, x += y or x -= y.
+ * @param x augend, receives the sum.
+ * @param y addend, rescaled in place.
+ * @param negate subtract y instead.
+ */
+inline void add_fixed(fixed_limbs &x, fixed_limbs &y, const bool negate)
+{
+    if (x.frac < y.frac)
+    { // align x to the finer scale
+        lmul_pow10(x.mag, y.frac - x.frac);
+        x.frac = y.frac;
+    }
+    else if (y.frac < x.frac)
+    { // align y to the finer scale
+        lmul_pow10(y.mag, x.frac - y.frac);
+        y.frac = x.frac;
+    }
+    x.sign = signed_liadd(x.mag, y.mag, x.sign, y.sign != negate);
+}
+
+/**
+ * @brief Unpack fixed point limbs into a number.
+ * @param x value to unpack, rounded in place.
+ * @param dst number receiving the value.
+ * @param max_fraction maximum fraction digits of the result.
+ * @param mode rounding of the discarded digits.
+ */
+inline void unpack_fixed(fixed_limbs &x, mnum &dst,
+                         const size_t max_fraction = getcontext().max_fraction,
+                         const rounding mode = getcontext().mode)
+{
+    if (x.frac > max_fraction)
+    { // round before unpacking the digits
+        lround(x.mag, x.frac - max_fraction, mode, x.sign);
+        x.frac = max_fraction;
+    }
+    dst.mag = std::move(x.mag);
+    dst.frac = x.frac;
+    strip_fraction(dst.mag, dst.frac);
+    dst.sign = x.sign;
+}
+
+/* =======================================================*
+ *                   EXPRESSION NODES                     *
+   =======================================================*/
+
+struct mexpr_base
+{
+};
+
+/**
+ * @brief Base of every expression, E is the derived node.
+ */
+template <typename E>
+struct mexpr : mexpr_base
+{
+    // evaluate into dst, reusing its digit storage
+    void assign_to(mnum &dst) const
+    {
+        fixed_limbs value = static_cast<const E &>(*this).eval();
+        unpack_fixed(value, dst);
+    }
+    operator mnum() const
+    {
+        mnum result(0);
+        this->assign_to(result);
+        return result;
+    }
+};
+
+/**
+ * @brief Leaf referring to an mnum operand.
+ */
+struct mexpr_ref : mexpr<mexpr_ref>
+{
+    const mnum &x;
+
+    explicit mexpr_ref(const mnum &x) noexcept : x(x) {}
+    fixed_limbs eval() const { return pack_fixed(this->x); }
+    const mnum *leaf() const noexcept { return &this->x; }
+};
+
+enum mexpr_op
+{
+    MEXPR_ADD,
+    MEXPR_SUB,
+    MEXPR_MUL
+};
+
+/**
+ * @brief Binary operation on two subexpressions.
+ */
+template <typename L, typename R, mexpr_op Op>
+struct mexpr_bin : mexpr<mexpr_bin<L, R, Op>>
+{
+    const L l;
+    const R r;
+
+    mexpr_bin(const L &l, const R &r) : l(l), r(r) {}
+    const mnum *leaf() const noexcept { return nullptr; }
+
+    fixed_limbs eval() const
+    {
+        fixed_limbs x = this->l.eval();
+        const mnum *lx = this->l.leaf(), *ly = this->r.leaf();
+        if (Op == MEXPR_MUL && lx && ly &&
+            (lx == ly || cmp(lx->mag, lx->frac, ly->mag, ly->frac) == 0))
+        { // square of equal operands
+            x.mag = lsqr(x.mag);
+            x.frac *= 2;
+            x.sign = lx->sign != ly->sign;
+            return x;
+        }
+        fixed_limbs y = this->r.eval();
+        if (Op != MEXPR_MUL)
+        {
+            add_fixed(x, y, Op == MEXPR_SUB);
+            return x;
+        }
+        x.mag = lmul(x.mag, y.mag);
+        x.frac += y.frac;
+        x.sign = x.sign ^ y.sign;
+        return x;
+    }
+};
+
+/* =======================================================*
+ *                       OPERATORS                        *
+   =======================================================*/
+
+template <typename T>
+struct is_mexpr : std::is_base_of<mexpr_base, T>
+{
+};
+
+// node type of an operand, plain numbers become leaves.
+template <typename T>
+using mexpr_node = typename std::conditional<is_mexpr<T>::value, T, mexpr_ref>::type;
+
+// operators apply when one side is an expression and the other an expression or mnum.
+template <typename L, typename R>
+using enable_mexpr = typename std::enable_if<
+    (is_mexpr<L>::value && (is_mexpr<R>::value || std::is_same<R, mnum>::value)) ||
+    (std::is_same<L, mnum>::value && is_mexpr<R>::value)>::type;
+
+/**
+ * @brief Start an expression from a number.
+ * @param x operand, referenced until the expression is evaluated.
+ */
+inline mexpr_ref lazy(const mnum &x) noexcept
+{
+    return mexpr_ref(x);
+}
+
+template <typename E>
+inline const E &as_mexpr(const mexpr<E> &x) noexcept
+{
+    return static_cast<const E &>(x);
+}
+
+inline mexpr_ref as_mexpr(const mnum &x) noexcept
+{
+    return mexpr_ref(x);
+}
+
+template <typename L, typename R, typename = enable_mexpr<L, R>>
+inline mexpr_bin<mexpr_node<L>, mexpr_node<R>, MEXPR_ADD>
+operator+(const L &l, const R &r)
+{
+    return {as_mexpr(l), as_mexpr(r)};
+}
+
+template <typename L, typename R, typename = enable_mexpr<L, R>>
+inline mexpr_bin<mexpr_node<L>, mexpr_node<R>, MEXPR_SUB>
+operator-(const L &l, const R &r)
+{
+    return {as_mexpr(l), as_mexpr(r)};
+}
+
+template <typename L, typename R, typename = enable_mexpr<L, R>>
+inline mexpr_bin<mexpr_node<L>, mexpr_node<R>, MEXPR_MUL>
+operator*(const L &l, const R &r)
+{
+    return {as_mexpr(l), as_mexpr(r)};
+}
+
+#endif // MEXPR_H
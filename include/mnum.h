@@ -1,289 +1,551 @@
 #ifndef MNUM_H
 #define MNUM_H
 #include <algorithm>
+#include <utility>
 #include "fmath.h"
+#include "dconv.h"
 
 class mnum
 {
 public:
     bool sign;
-    std::vector<udigit> integer;
-    std::vector<udigit> fraction;
+    limb_vector mag; // magnitude * 10^frac, base 10^9 limbs
+    size_t frac;     // number of fraction digits
 
-public:
-    mnum(const mnum &self) noexcept
+private:
+    // unpack the decimal digits, a zero fraction is {0}
+    void unpack(digit_vector &x, digit_vector &fx) const
+    {
+        digit_vector digits = from_limbs(this->mag);
+        if (digits.size() <= this->frac) // pad to keep an integer digit
+            digits.insert(digits.begin(), this->frac - digits.size() + 1, 0);
+        const size_t dec_point = digits.size() - this->frac;
+        x.assign(digits.begin(), digits.begin() + dec_point);
+        if (this->frac)
+            fx.assign(digits.begin() + dec_point, digits.end());
+        else
+            fx.assign(1, 0);
+    }
+    // pack decimal digits, a zero fraction is {0}
+    void pack(const digit_vector &x, const digit_vector &fx)
     {
-        this->sign = self.sign;
-        this->integer = self.integer;
-        this->fraction = self.fraction;
+        const bool is_frac_zero = fx.size() == 1 && fx[0] == 0;
+        this->frac = is_frac_zero ? 0 : fx.size();
+        if (is_frac_zero)
+        {
+            this->mag = to_limbs(x);
+            return;
+        }
+        digit_vector xfx;
+        xfx.reserve(x.size() + fx.size());
+        xfx.assign(x.begin(), x.end());
+        xfx.insert(xfx.end(), fx.begin(), fx.end());
+        this->mag = to_limbs(xfx);
     }
-    mnum(const std::vector<udigit> &integer,
-         const std::vector<udigit> &fraction,
+
+public:
+    mnum(const mnum &self) = default;
+    mnum(mnum &&self) noexcept = default;
+    mnum &operator=(const mnum &self) = default;
+    mnum &operator=(mnum &&self) noexcept = default;
+    // limbs are taken by value, pass temporaries to move them in
+    mnum(limb_vector mag,
+         const size_t frac,
          const bool sign) noexcept
+        : sign(sign), mag(std::move(mag)), frac(frac)
     {
-        this->sign = sign;
-        this->integer = integer;
-        this->fraction = fraction;
     }
-    mnum(const int_fast64_t &num) noexcept
+    mnum(const int_fast64_t &num)
     {
         this->sign = num < 0;
-        this->integer = convert(std::abs(num));
-        this->fraction = {0};
+        from_machine(machine_abs(num), this->mag);
+        this->frac = 0;
     }
     mnum(const std::string &num_str)
     {
         this->sign = convert_num_str(
-            num_str, this->integer,
-            this->fraction);
+            num_str, this->mag,
+            this->frac);
+    }
+    // decimal digits, integer part first and fraction part second
+    mnum(const digit_vector &integer,
+         const digit_vector &fraction,
+         const bool sign)
+        : sign(sign)
+    {
+        this->pack(integer, fraction);
+    }
+    // shortest digits that round back to value, or its exact binary expansion
+    static mnum from_double(const double value, const bool exact = false)
+    {
+        limb_vector x;
+        size_t fx;
+        const bool sign = double_digits(value, exact, x, fx);
+        return mnum(std::move(x), fx, sign);
+    }
+    // nearest double to the value
+    double to_double() const
+    {
+        return digits_double(this->mag, this->frac, this->sign);
     }
-    bool operator==(const mnum &y) const noexcept
+    bool is_zero() const noexcept
     {
-        if (this->integer.front() == 0 && y.integer.front() == 0 &&
-            this->fraction.size() == 1 && this->fraction.front() == 0 &&
-            y.fraction.size() == 1 && y.fraction.front() == 0)
+        return this->mag.empty();
+    }
+    bool operator==(const mnum &y) const
+    {
+        if (this->is_zero() && y.is_zero())
             return true;
         if (this->sign != y.sign)
             return false;
-        return cmp(this->integer, this->fraction, y.integer, y.fraction) == 0;
+        return cmp(this->mag, this->frac, y.mag, y.frac) == 0;
     }
-    bool operator!=(const mnum &y) const noexcept
+    bool operator!=(const mnum &y) const
     {
-        if (this->integer.front() == 0 && y.integer.front() == 0 &&
-            this->fraction.size() == 1 && this->fraction.front() == 0 &&
-            y.fraction.size() == 1 && y.fraction.front() == 0)
-            return false;
-        if (this->sign != y.sign)
-            return true;
-        return cmp(this->integer, this->fraction, y.integer, y.fraction) != 0;
+        return !(*this == y);
     }
-    bool operator<(const mnum &y) const noexcept
+    bool operator<(const mnum &y) const
     {
-        const short comp = cmp(
-            this->integer, this->fraction, y.integer, y.fraction);
+        const short comp = cmp(this->mag, this->frac, y.mag, y.frac);
         if (comp == 0)
         {
-            if (this->integer.front() == 0 &&
-                y.integer.front() == 0)
+            if (this->is_zero())
                 return false;
             return this->sign > y.sign;
         }
         if (this->sign && y.sign) // both negative
-            return comp == -1;
+            return comp == 1;
         if (this->sign < y.sign) // y is negative
             return false;
         return this->sign > y.sign || comp == -1;
     }
-    bool operator>(const mnum &y) const noexcept
+    bool operator>(const mnum &y) const
     {
-        const short comp = cmp(
-            this->integer, this->fraction, y.integer, y.fraction);
-        if (comp == 0)
-        {
-            if (this->integer.front() == 0 &&
-                y.integer.front() == 0)
-                return false;
-            return this->sign < y.sign;
-        }
-        if (this->sign && y.sign) // both negative
-            return comp == -1;
-        if (this->sign > y.sign) // y is negative
-            return false;
-        return this->sign < y.sign || comp == 1;
+        return y < *this;
     }
-    bool operator<=(const mnum &y) const noexcept
+    bool operator<=(const mnum &y) const
     {
-        const short comp = cmp(
-            this->integer, this->fraction, y.integer, y.fraction);
-        if (comp == 0)
-        {
-            if (this->integer.front() == 0 &&
-                y.integer.front() == 0)
-                return true;
-            return this->sign > y.sign || this->sign == y.sign;
-        }
-        if (this->sign && y.sign) // both negative
-            return comp == -1;
-        if (this->sign < y.sign) // y is negative
-            return false;
-        return this->sign > y.sign || comp == -1;
+        return !(y < *this);
     }
-    bool operator>=(const mnum &y) const noexcept
+    bool operator>=(const mnum &y) const
     {
-        const short comp = cmp(
-            this->integer, this->fraction, y.integer, y.fraction);
-        if (comp == 0)
+        return !(*this < y);
+    }
+    // compare with a machine integer: 0 if equal, -1 if lesser, 1 if greater
+    short compare(const int_fast64_t y) const
+    {
+        const bool ysign = y < 0;
+        const uint64_t b = machine_abs(y);
+        short comp;
+        if (fits_machine(this->mag, this->frac))
+        { // native comparison of machine words
+            const uint64_t a = to_machine(this->mag);
+            comp = a == b ? 0 : (a > b ? 1 : -1);
+        }
+        else
         {
-            if (this->integer.front() == 0 &&
-                y.integer.front() == 0)
-                return true;
-            return this->sign < y.sign || this->sign == y.sign;
+            limb_vector yl;
+            from_machine(b, yl);
+            comp = cmp(this->mag, this->frac, yl, 0);
         }
-        if (this->sign && y.sign) // both negative
-            return comp == -1;
-        if (this->sign > y.sign) // y is negative
-            return false;
-        return this->sign < y.sign || comp == 1;
+        if (comp == 0 && y == 0)
+            return 0; // zero is unsigned
+        if (this->sign != ysign)
+            return this->sign ? -1 : 1;
+        return this->sign ? -comp : comp;
     }
-    mnum abs() const noexcept
+    bool operator==(const int_fast64_t y) const
     {
-        return mnum(this->integer, this->fraction, false);
+        return this->compare(y) == 0;
     }
-    mnum operator+() const noexcept
+    bool operator!=(const int_fast64_t y) const
     {
-        return mnum(this->integer, this->fraction, this->sign);
+        return this->compare(y) != 0;
     }
-    mnum operator-() const noexcept
+    bool operator<(const int_fast64_t y) const
     {
-        return mnum(this->integer, this->fraction, !this->sign);
+        return this->compare(y) < 0;
     }
-    mnum operator+(const mnum &y) const
+    bool operator>(const int_fast64_t y) const
     {
-        std::vector<udigit> x, fx;
-        x = this->integer;
-        fx = this->fraction;
-        const bool sign = signed_iadd(
-            x, fx, y.integer, y.fraction,
-            this->sign, y.sign);
-        return mnum(x, fx, sign);
+        return this->compare(y) > 0;
+    }
+    bool operator<=(const int_fast64_t y) const
+    {
+        return this->compare(y) <= 0;
+    }
+    bool operator>=(const int_fast64_t y) const
+    {
+        return this->compare(y) >= 0;
+    }
+    mnum abs() const & noexcept
+    {
+        return mnum(this->mag, this->frac, false);
+    }
+    mnum abs() && noexcept
+    {
+        this->sign = false;
+        return std::move(*this);
+    }
+    mnum operator+() const & noexcept
+    {
+        return *this;
+    }
+    mnum operator+() && noexcept
+    {
+        return std::move(*this);
+    }
+    mnum operator-() const & noexcept
+    {
+        return mnum(this->mag, this->frac, !this->sign);
+    }
+    mnum operator-() && noexcept
+    {
+        this->sign = !this->sign;
+        return std::move(*this);
+    }
+    mnum operator+(const mnum &y) const &
+    {
+        mnum res(*this);
+        res += y;
+        return res;
+    }
+    // reuse the storage of a temporary left operand
+    mnum operator+(const mnum &y) &&
+    {
+        *this += y;
+        return std::move(*this);
     }
     void operator+=(const mnum &y)
     {
         this->sign = signed_iadd(
-            this->integer, this->fraction,
-            y.integer, y.fraction,
+            this->mag, this->frac,
+            y.mag, y.frac,
             this->sign, y.sign);
     }
-    mnum operator-(const mnum &y) const
+    mnum operator+(const int_fast64_t y) const &
     {
-        std::vector<udigit> x, fx;
-        x = this->integer;
-        fx = this->fraction;
-        const bool sign = signed_isub(
-            x, fx, y.integer, y.fraction,
-            this->sign, y.sign);
-        return mnum(x, fx, sign);
+        mnum res(*this);
+        res += y;
+        return res;
+    }
+    mnum operator+(const int_fast64_t y) &&
+    {
+        *this += y;
+        return std::move(*this);
+    }
+    void operator+=(const int_fast64_t y)
+    {
+        this->sign = signed_iadd_small(
+            this->mag, this->frac,
+            machine_abs(y), this->sign, y < 0);
+    }
+    mnum operator-(const mnum &y) const &
+    {
+        mnum res(*this);
+        res -= y;
+        return res;
+    }
+    mnum operator-(const mnum &y) &&
+    {
+        *this -= y;
+        return std::move(*this);
     }
     void operator-=(const mnum &y)
     {
         this->sign = signed_isub(
-            this->integer, this->fraction,
-            y.integer, y.fraction,
+            this->mag, this->frac,
+            y.mag, y.frac,
             this->sign, y.sign);
     }
-    mnum operator*(const mnum &y) const
+    mnum operator-(const int_fast64_t y) const &
+    {
+        mnum res(*this);
+        res -= y;
+        return res;
+    }
+    mnum operator-(const int_fast64_t y) &&
+    {
+        *this -= y;
+        return std::move(*this);
+    }
+    void operator-=(const int_fast64_t y)
+    {
+        this->sign = signed_iadd_small(
+            this->mag, this->frac,
+            machine_abs(y), this->sign, !(y < 0));
+    }
+    mnum operator*(const mnum &y) const &
     {
-        std::vector<udigit> x, fx;
-        x = this->integer, fx = this->fraction;
-        imul(x, fx, y.integer, y.fraction);
-        return mnum(x, fx, this->sign ^ y.sign);
+        mnum res(*this);
+        res *= y;
+        return res;
+    }
+    mnum operator*(const mnum &y) &&
+    {
+        *this *= y;
+        return std::move(*this);
     }
     void operator*=(const mnum &y)
     {
-        imul(this->integer, this->fraction,
-             y.integer, y.fraction);
         this->sign = this->sign ^ y.sign;
+        imul(this->mag, this->frac,
+             y.mag, y.frac, this->sign);
+    }
+    mnum operator*(const int_fast64_t y) const &
+    {
+        mnum res(*this);
+        res *= y;
+        return res;
+    }
+    mnum operator*(const int_fast64_t y) &&
+    {
+        *this *= y;
+        return std::move(*this);
+    }
+    void operator*=(const int_fast64_t y)
+    {
+        const uint64_t mag = machine_abs(y);
+        if (mag >= MACHINE_LIMIT)
+            return *this *= mnum(y);
+        this->sign = this->sign ^ (y < 0);
+        imul_small(this->mag, this->frac, mag, this->sign);
     }
     mnum operator/(const mnum &y) const
     {
-        std::pair<std::vector<udigit>, std::vector<udigit>> div;
-        div = true_div(this->integer, this->fraction, y.integer, y.fraction);
-        return mnum(div.first, div.second, this->sign ^ y.sign);
+        return this->true_div(y, div_precision());
     }
     void operator/=(const mnum &y)
     {
-        std::pair<std::vector<udigit>, std::vector<udigit>> div;
-        div = true_div(this->integer, this->fraction, y.integer, y.fraction);
-        this->integer.swap(div.first);
-        this->fraction.swap(div.second);
-        this->sign = this->sign ^ y.sign;
+        const bool sign = this->sign ^ y.sign;
+        std::pair<limb_vector, size_t> div;
+        div = ::true_div(this->mag, this->frac, y.mag,
+                         y.frac, div_precision(), getcontext().mode, sign);
+        this->mag.swap(div.first);
+        this->frac = div.second;
+        this->sign = sign;
+    }
+    // perform true division to the given fraction digits
+    mnum true_div(const mnum &y, const size_t precision) const
+    {
+        const bool sign = this->sign ^ y.sign;
+        std::pair<limb_vector, size_t> div;
+        div = ::true_div(this->mag, this->frac, y.mag,
+                         y.frac, precision, getcontext().mode, sign);
+        return mnum(std::move(div.first), div.second, sign);
+    }
+    // fraction digits of division bounded by the context
+    static size_t div_precision() noexcept
+    {
+        const context &ctx = getcontext();
+        return std::min(ctx.precision, ctx.max_fraction);
     }
     mnum div(const mnum &y) const
     {
-        std::vector<udigit> quot = \
-        divmod(this->integer, this->fraction, y.integer, y.fraction).first;
-        return mnum(quot, {0}, this->sign ^ y.sign);
+        limb_vector quot = \
+        divmod(this->mag, this->frac, y.mag, y.frac).first;
+        return mnum(std::move(quot), 0, this->sign ^ y.sign);
     }
     void idiv(const mnum &y)
     {
-        std::vector<udigit> zero(1, 0), quot = \
-        divmod(this->integer, this->fraction, y.integer, y.fraction).first;
-        this->integer.swap(quot);
-        this->fraction.swap(zero);
+        limb_vector quot = \
+        divmod(this->mag, this->frac, y.mag, y.frac).first;
+        this->mag.swap(quot);
+        this->frac = 0;
         this->sign = this->sign ^ y.sign;
     }
     // perform floor division
     mnum floor_div(const mnum &y) const
     {
-        const std::pair<std::vector<udigit>, bool> div =
+        std::pair<limb_vector, bool> div =
             signed_floor_div(
-                this->integer, this->fraction,
-                y.integer, y.fraction, this->sign, y.sign);
-        return mnum(div.first, {0}, div.second);
+                this->mag, this->frac,
+                y.mag, y.frac, this->sign, y.sign);
+        return mnum(std::move(div.first), 0, div.second);
     }
     // perform inplace floor division
     void ifloor_div(const mnum &y)
     {
-        std::pair<std::vector<udigit>, bool> div;
+        std::pair<limb_vector, bool> div;
         div = signed_floor_div(
-            this->integer, this->fraction,
-            y.integer, y.fraction, this->sign, y.sign);
-        std::vector<udigit> zero(1, 0);
-        this->integer.swap(div.first);
-        this->fraction.swap(zero);
+            this->mag, this->frac,
+            y.mag, y.frac, this->sign, y.sign);
+        this->mag.swap(div.first);
+        this->frac = 0;
         this->sign = div.second;
     }
-    mnum operator%(const mnum &y) const
+    mnum floor_div(const int_fast64_t y) const
     {
-        std::vector<udigit> x, fx;
-        x = this->integer, fx = this->fraction;
-        const bool sign = signed_imod(
-            x, fx, y.integer, y.fraction,
-            this->sign, y.sign);
-        return mnum(x, fx, sign);
+        std::pair<limb_vector, bool> div =
+            signed_floor_div_small(
+                this->mag, this->frac,
+                machine_abs(y), this->sign, y < 0);
+        return mnum(std::move(div.first), 0, div.second);
+    }
+    void ifloor_div(const int_fast64_t y)
+    {
+        std::pair<limb_vector, bool> div;
+        div = signed_floor_div_small(
+            this->mag, this->frac,
+            machine_abs(y), this->sign, y < 0);
+        this->mag.swap(div.first);
+        this->frac = 0;
+        this->sign = div.second;
+    }
+    mnum operator%(const mnum &y) const &
+    {
+        mnum res(*this);
+        res %= y;
+        return res;
+    }
+    mnum operator%(const mnum &y) &&
+    {
+        *this %= y;
+        return std::move(*this);
     }
     void operator%=(const mnum &y)
     {
         this->sign = signed_imod(
-            this->integer, this->fraction,
-            y.integer, y.fraction,
+            this->mag, this->frac,
+            y.mag, y.frac,
             this->sign, y.sign);
     }
+    mnum operator%(const int_fast64_t y) const &
+    {
+        mnum res(*this);
+        res %= y;
+        return res;
+    }
+    mnum operator%(const int_fast64_t y) &&
+    {
+        *this %= y;
+        return std::move(*this);
+    }
+    void operator%=(const int_fast64_t y)
+    {
+        this->sign = signed_imod_small(
+            this->mag, this->frac,
+            machine_abs(y), this->sign, y < 0);
+    }
     mnum pow(const mnum &y) const
     {
-        const std::pair<std::vector<udigit>, std::vector<udigit>> res =
-            signed_power(this->integer, this->fraction,
-                         y.integer, y.fraction, this->sign, y.sign);
-        return mnum(res.first, res.second, this->sign);
+        return this->pow_prec(y, div_precision());
+    }
+    // perform power, negative exponents divide to the given fraction digits
+    mnum pow_prec(const mnum &y, const size_t precision) const
+    {
+        std::pair<limb_vector, size_t> res =
+            signed_power(this->mag, this->frac, y.mag,
+                         y.frac, this->sign, y.sign, precision);
+        return mnum(std::move(res.first), res.second, this->sign);
+    }
+    // perform modular power, result takes the sign of mod
+    mnum pow(const mnum &y, const mnum &mod) const
+    {
+        std::pair<limb_vector, bool> res =
+            signed_powmod(this->mag, this->frac,
+                          y.mag, y.frac, mod.mag, mod.frac,
+                          this->sign, y.sign, mod.sign);
+        return mnum(std::move(res.first), 0, res.second);
+    }
+    // integer square root of the integer part
+    mnum isqrt() const
+    {
+        const mnum x = this->as_int();
+        if (x.sign && !x.is_zero())
+            throw std::domain_error("square root of negative number");
+        return mnum(lroot(x.mag, 2), 0, false);
+    }
+    mnum sqrt(const size_t precision = div_precision()) const
+    {
+        return this->nth_root(2, precision);
+    }
+    mnum nth_root(const size_t n, const size_t precision = div_precision()) const
+    {
+        std::pair<limb_vector, size_t> res =
+            signed_root(this->mag, this->frac, n, this->sign,
+                        precision, getcontext().mode);
+        return mnum(std::move(res.first), res.second, this->sign);
+    }
+    // round the fraction to the given digits
+    mnum quantize(const size_t digits,
+                  const rounding mode = getcontext().mode) const
+    {
+        mnum res(*this);
+        fround(res.mag, res.frac, digits, res.sign, mode);
+        return res;
     }
-    mnum as_int() const noexcept
+    mnum as_int() const &
     {
-        return mnum(this->integer, {0}, this->sign);
+        limb_vector x, fx;
+        lsplit(this->mag, this->frac, x, fx);
+        return mnum(std::move(x), 0, this->sign);
     }
-    mnum as_float() const noexcept
+    mnum as_int() &&
     {
-        return mnum({0}, this->fraction, this->sign);
+        ltruncate(this->mag, this->frac);
+        this->frac = 0;
+        return std::move(*this);
     }
-    mnum frac_part() const noexcept
+    mnum as_float() const
     {
-        return mnum(this->fraction, {0}, this->sign);
+        limb_vector x, fx;
+        lsplit(this->mag, this->frac, x, fx);
+        return mnum(std::move(fx), this->frac, this->sign);
+    }
+    mnum frac_part() const
+    {
+        limb_vector x, fx;
+        lsplit(this->mag, this->frac, x, fx);
+        return mnum(std::move(fx), 0, this->sign);
+    }
+    /* ========================================================
+       *            DECIMAL VIEW OF THE DIGITS                *
+       =======================================================*/
+    // number of integer digits, a zero integer part has one
+    size_t int_size() const noexcept
+    {
+        const size_t size = ldigits(this->mag);
+        return size > this->frac ? size - this->frac : 1;
     }
     size_t size() const noexcept
     {
-        const size_t frac_size = this->fraction.size();
-        const bool is_frac_zero = frac_size == 1 && this->fraction[0] == 0;
-        return this->integer.size() + (is_frac_zero ? 0 : frac_size);
+        return this->int_size() + this->frac;
     }
-    udigit &operator[](const size_t &index) noexcept
+    // digit at index, counted from the most significant integer digit
+    udigit operator[](const size_t &index) const noexcept
     {
-        const size_t size = this->integer.size();
-        if (index < size)
-            return this->integer[index];
-        return this->fraction[index - size];
+        return ldigit(this->mag, this->size() - 1 - index);
+    }
+    // replace the digit at index
+    void assign(const size_t &index, const udigit value)
+    {
+        digit_vector x, fx;
+        this->unpack(x, fx);
+        if (index < x.size())
+        {
+            x[index] = value;
+            lstrip_zeros(x); // normalize integer
+        }
+        else
+        {
+            fx[index - x.size()] = value;
+            rstrip_zeros(fx); // normalize fraction
+        }
+        this->pack(x, fx);
+    }
+    // append a digit to the fraction, or to the integer if there is none
+    void append(const udigit value)
+    {
+        lmul_small(this->mag, 10);
+        if (value)
+            liadd(this->mag, {value});
+        if (this->frac)
+            ++this->frac;
     }
-    static const bool contains(
-        const std::vector<udigit> &x,
-        const std::vector<udigit> &y) noexcept
+    static bool contains(
+        const digit_vector &x,
+        const digit_vector &y) noexcept
     {
         const size_t x_size = x.size();
         const size_t y_size = y.size();
@@ -305,55 +567,31 @@ public:
         }
         return false;
     }
-    bool contains(const mnum &y) const noexcept
+    bool contains(const mnum &y) const
     {
-        if (y.fraction.size() == 1 && y.fraction[0] == 0)
-            return this->contains(y.integer, this->integer) ||
-                (!(this->fraction.size() == 1 && this->fraction[0] == 0) &&
-                this->contains(y.integer, this->fraction));
+        digit_vector x, fx, yx, yfx;
+        this->unpack(x, fx);
+        y.unpack(yx, yfx);
+        if (y.frac == 0)
+            return this->contains(yx, x) ||
+                (this->frac != 0 && this->contains(yx, fx));
 
-        return this->contains(y.integer, this->integer) &&
-                this->contains(y.fraction, this->fraction);
+        return this->contains(yx, x) &&
+                this->contains(yfx, fx);
     }
     int_fast64_t find(const udigit &value) const noexcept
     {
-        size_t idx = 0;
-        const udigit *ptr = this->integer.data();
-        const udigit *end = ptr + this->integer.size();
-        for (; ptr != end; ++ptr, ++idx)
-            if (*ptr == value)
-                return idx;
-        const size_t frac_size = this->fraction.size();
-        if (frac_size == 1 && this->fraction[0] == 0)
-            return -1; // stop search if fraction is zero
-        const udigit *fptr = this->fraction.data();
-        const udigit *fend = fptr + frac_size;
-        for (; fptr != fend; ++fptr, ++idx)
-            if (*fptr == value)
+        const size_t size = this->size();
+        for (size_t idx = 0; idx < size; ++idx)
+            if ((*this)[idx] == value)
                 return idx;
         return -1;
     }
     int_fast64_t rfind(const udigit &value) const noexcept
     {
-        const size_t int_size = this->integer.size();
-        const size_t frac_size = this->fraction.size();
-        size_t idx = int_size - 1;
-        if ((frac_size == 1 && this->fraction[0] == 0))
-            idx = int_size - 1;
-        else
-        {
-            idx += frac_size;
-            auto it_fend = this->fraction.rend();
-            for (auto it = this->fraction.rbegin();
-                 it != it_fend; ++it, --idx)
-                if (*it == value)
-                    return idx;
-        }
-        auto it_end = this->integer.rend();
-        for (auto it = this->integer.rbegin();
-             it != it_end; ++it, --idx)
-            if (*it == value)
-                return idx;
+        for (size_t idx = this->size(); idx > 0; --idx)
+            if ((*this)[idx - 1] == value)
+                return idx - 1;
         return -1;
     }
     size_t index(const udigit &value) const
@@ -366,97 +604,77 @@ public:
     size_t count(const udigit &value) const noexcept
     {
         size_t c = 0;
-        const udigit *ptr = this->integer.data();
-        const udigit *end = ptr + this->integer.size();
-        for (; ptr != end; ++ptr)
-            if (*ptr == value)
-                ++c;
-        const size_t frac_size = this->fraction.size();
-        if (frac_size == 1 && this->fraction[0] == 0)
-            return c; // stop counting if fraction is zero
-        const udigit *fptr = this->fraction.data();
-        const udigit *fend = fptr + frac_size;
-        for (; fptr != fend; ++fptr)
-            if (*fptr == value)
+        const size_t size = this->size();
+        for (size_t idx = 0; idx < size; ++idx)
+            if ((*this)[idx] == value)
                 ++c;
         return c;
     }
-    void join(const mnum &y) noexcept
+    void join(const mnum &y)
     {
-        this->sign = this->sign || y.sign;
-        const size_t int_size = y.integer.size();
-        const size_t frac_size = y.fraction.size();
-        const bool int_zero = int_size == 1 && y.integer[0] == 0;
-        const bool frac_zero = frac_size == 1 && y.fraction[0] == 0;
-        if (!int_zero || (int_zero && frac_zero))
-        {
-            this->integer.insert(this->integer.end(), y.integer.begin(), y.integer.end());
-            lstrip_zeros(this->integer); // normalize integer
-        }
-        if (!frac_zero)
-        {   
-            if (this->fraction.size() == 1 && this->fraction[0] == 0)
-                this->fraction.clear(); // remove zero before inserting new fractions
-            this->fraction.insert(this->fraction.end(), y.fraction.begin(), y.fraction.end());
-            rstrip_zeros(this->fraction); // normalize fraction
-        }
+        *this = this->add(y);
     }
-    mnum add(const mnum &y) const noexcept
+    mnum add(const mnum &y) const
     {
-        std::vector<udigit> x, fx;
-        x = this->integer, fx = this->fraction;
-        const size_t int_size = y.integer.size();
-        const size_t frac_size = y.fraction.size();
-        const bool int_zero = int_size == 1 && y.integer[0] == 0;
-        const bool frac_zero = frac_size == 1 && y.fraction[0] == 0;
+        digit_vector x, fx, yx, yfx;
+        this->unpack(x, fx);
+        y.unpack(yx, yfx);
+        const bool int_zero = y.int_size() == 1 && yx[0] == 0;
+        const bool frac_zero = y.frac == 0;
         if (!int_zero || (int_zero && frac_zero))
         {
-            x.insert(x.end(), y.integer.begin(), y.integer.end());
+            x.insert(x.end(), yx.begin(), yx.end());
             lstrip_zeros(x); // normalize integer
         }
         if (!frac_zero)
         {
-            if (fx.size() == 1 && fx[0] == 0)
+            if (this->frac == 0)
                 fx.clear(); // remove zero before inserting new fractions
-            fx.insert(fx.end(), y.fraction.begin(), y.fraction.end());
+            fx.insert(fx.end(), yfx.begin(), yfx.end());
             rstrip_zeros(fx); // normalize fraction
         }
         return mnum(x, fx, this->sign || y.sign);
     }
     void insert(const size_t &index, udigit value)
     {
-        const size_t size = this->integer.size();
+        digit_vector x, fx;
+        this->unpack(x, fx);
+        const size_t size = x.size();
         if (index < size)
         {
-            this->integer.insert(this->integer.begin() + index, value);
-            lstrip_zeros(this->integer); // normalize integer
+            x.insert(x.begin() + index, value);
+            lstrip_zeros(x); // normalize integer
         }
         else
         {
-            this->fraction.insert(this->fraction.begin() + index - size, value);
-            rstrip_zeros(this->fraction); // normalize fraction
+            fx.insert(fx.begin() + index - size, value);
+            rstrip_zeros(fx); // normalize fraction
         }
+        this->pack(x, fx);
     }
-    void erase(const size_t &index) noexcept
+    void erase(const size_t &index)
     {
-        const size_t size = this->integer.size();
+        digit_vector x, fx;
+        this->unpack(x, fx);
+        const size_t size = x.size();
         if (index < size)
         {
-            this->integer.erase(this->integer.begin() + index);
-            lstrip_zeros(this->integer); // normalize integer
+            x.erase(x.begin() + index);
+            lstrip_zeros(x); // normalize integer
         }
         else
         {
-            this->fraction.erase(this->fraction.begin() + index - size);
-            rstrip_zeros(this->fraction); // normalize fraction
+            fx.erase(fx.begin() + index - size);
+            rstrip_zeros(fx); // normalize fraction
         }
+        this->pack(x, fx);
     }
-    mnum pop(const int_fast64_t &index) noexcept
+    mnum pop(const int_fast64_t &index)
     {
         const size_t idx = index < 0 ? this->size() + index : index;
         const udigit value = (*this)[idx];
         this->erase(idx);
-        return mnum({value}, {0}, false);
+        return mnum(static_cast<int_fast64_t>(value));
     }
     void remove(const udigit &value)
     {
@@ -468,64 +686,43 @@ public:
     void clear() noexcept
     {
         this->sign = false;
-        std::vector<udigit> zero1(1, 0);
-        std::vector<udigit> zero2(1, 0);
-        this->integer.swap(zero1);
-        this->fraction.swap(zero2);
+        this->mag.clear();
+        this->frac = 0;
     }
-    void reverse() noexcept
+    void reverse()
     {
-        std::reverse(this->integer.begin(), this->integer.end());
-        std::reverse(this->fraction.begin(), this->fraction.end());
-        lstrip_zeros(this->integer); // normalize integer
-        rstrip_zeros(this->fraction); // normalize fraction
+        digit_vector x, fx;
+        this->unpack(x, fx);
+        std::reverse(x.begin(), x.end());
+        std::reverse(fx.begin(), fx.end());
+        lstrip_zeros(x); // normalize integer
+        rstrip_zeros(fx); // normalize fraction
+        this->pack(x, fx);
     }
-    void sort() noexcept
+    void sort()
     {
-        std::sort(this->integer.begin(), this->integer.end());
-        std::sort(this->fraction.begin(), this->fraction.end());
-        lstrip_zeros(this->integer); // normalize integer
-        rstrip_zeros(this->fraction); // normalize fraction
+        digit_vector x, fx;
+        this->unpack(x, fx);
+        std::sort(x.begin(), x.end());
+        std::sort(fx.begin(), fx.end());
+        lstrip_zeros(x); // normalize integer
+        rstrip_zeros(fx); // normalize fraction
+        this->pack(x, fx);
     }
     std::string float_str() const
     {
-        std::string result;
-        const size_t alloc_size =
-            this->integer.size() +
-            this->fraction.size();
-        if (!this->sign)
-            result.reserve(alloc_size);
-        else
-        {
-            result.reserve(alloc_size + 1);
-            result.push_back('-');
-        }
-        result.append(convert(this->integer));
-        result.push_back('.');
-        result.append(convert(this->fraction));
+        std::string result = this->sign ? "-" : "";
+        result += limbs_str(this->mag, this->frac + 1);
+        const size_t dec_point = result.size() - this->frac;
+        result.insert(dec_point, this->frac ? "." : ".0");
         return result;
     }
     std::string str() const
     {
-        const size_t frac_size = this->fraction.size();
-        const bool is_frac_zero = frac_size == 1 && this->fraction[0] == 0;
-
-        std::string result;
-        const size_t alloc_size =
-            this->integer.size() +
-            frac_size + (is_frac_zero ? 0 : 1);
-        if (!this->sign)
-            result.reserve(alloc_size);
-        else
-        {
-            result.reserve(alloc_size + 1);
-            result.push_back('-');
-        }
-        result.append(convert(this->integer));
-        if (is_frac_zero)
-            return result;
-        result.push_back('.');
-        result.append(convert(this->fraction));
+        std::string result = this->sign ? "-" : "";
+        result += limbs_str(this->mag, this->frac + 1);
+        if (this->frac)
+            result.insert(result.size() - this->frac, 1, '.');
         return result;
     }
 };
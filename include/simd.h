@@ -0,0 +1,336 @@
+#ifndef SIMD_H
+#define SIMD_H
+#include <iostream>
+#include <cstdint>
+#include "utils.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SIMD_X86 1
+#define SIMD_TARGET(isa)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+static_assert(sizeof(udigit) == 1, "digit kernels work on bytes");
+
+/*
+ * Digits are stored most significant first, so a block loaded from memory
+ * holds its least significant digit in the last lane. Lane masks are bit
+ * reversed, making carries run from low to high bits where one integer
+ * addition resolves them all: with generate g (digit sum > 9) and
+ * propagate p (digit sum == 9), the carries into each lane are
+ * (g + (g | p) + carry_in) ^ p, and the bit above the block is the carry
+ * out. Borrows use g (difference < 0) and p (difference == 0) likewise.
+ */
+
+/**
+ * @brief Perform digit range addition (portable).
+ * @param x augend, receives the sum.
+ * @param y addend.
+ * @param size number of digits in both ranges.
+ * @param carry carry into the least significant digit.
+ * @return carry out of the most significant digit.
+ */
+inline udigit add_digits_scalar(udigit *x, const udigit *y, size_t size, udigit carry) noexcept
+{
+    while (size > 0)
+    {
+        --size;
+        const udigit res = x[size] + y[size] + carry;
+        carry = res > 9;
+        x[size] = carry ? res - 10 : res;
+    }
+    return carry;
+}
+
+/**
+ * @brief Perform digit range subtraction (portable).
+ * @param x minuend, receives the difference.
+ * @param y subtrahend.
+ * @param size number of digits in both ranges.
+ * @param borrow borrow from the least significant digit.
+ * @param reverse compute y - x instead of x - y.
+ * @return borrow out of the most significant digit.
+ */
+inline udigit sub_digits_scalar(udigit *x, const udigit *y, size_t size,
+                                udigit borrow, const bool reverse) noexcept
+{
+    while (size > 0)
+    {
+        --size;
+        const int_fast8_t res = reverse ? y[size] - x[size] - borrow
+                                        : x[size] - y[size] - borrow;
+        borrow = res < 0;
+        x[size] = static_cast<udigit>(borrow ? res + 10 : res);
+    }
+    return borrow;
+}
+
+#ifdef SIMD_X86
+
+/**
+ * @brief Reverse the bits of a 32 bit mask.
+ */
+inline uint32_t reverse_bits(uint32_t x) noexcept
+{
+    x = ((x >> 1) & 0x55555555U) | ((x & 0x55555555U) << 1);
+    x = ((x >> 2) & 0x33333333U) | ((x & 0x33333333U) << 2);
+    x = ((x >> 4) & 0x0F0F0F0FU) | ((x & 0x0F0F0F0FU) << 4);
+    x = ((x >> 8) & 0x00FF00FFU) | ((x & 0x00FF00FFU) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+/**
+ * @brief Resolve the carries of a block from lane masks.
+ * @param gen lanes generating a carry.
+ * @param prop lanes propagating a carry.
+ * @param lanes number of lanes in the block.
+ * @param carry carry into the block, receives the carry out.
+ * @return lanes receiving a carry.
+ */
+inline uint32_t resolve_carries(const uint32_t gen, const uint32_t prop,
+                                const unsigned lanes, udigit &carry) noexcept
+{
+    const uint64_t g = reverse_bits(gen) >> (32 - lanes);
+    const uint64_t p = reverse_bits(prop) >> (32 - lanes);
+    const uint64_t c = (g + (g | p) + carry) ^ p;
+    carry = static_cast<udigit>((c >> lanes) & 1);
+    return reverse_bits(static_cast<uint32_t>(c)) >> (32 - lanes);
+}
+
+/**
+ * @brief Expand a 16 bit lane mask to bytes of all ones.
+ */
+SIMD_TARGET("sse4.1")
+inline __m128i expand_mask_sse(const uint32_t mask) noexcept
+{
+    const __m128i spread = _mm_shuffle_epi8(
+        _mm_set1_epi16(static_cast<short>(mask)),
+        _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
+    const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                       1, 2, 4, 8, 16, 32, 64, -128);
+    return _mm_cmpeq_epi8(_mm_and_si128(spread, bits), bits);
+}
+
+SIMD_TARGET("sse4.1")
+udigit add_digits_sse(udigit *x, const udigit *y, size_t size, udigit carry) noexcept
+{
+    const __m128i nine = _mm_set1_epi8(9), ten = _mm_set1_epi8(10);
+    while (size >= 16)
+    {
+        size -= 16;
+        __m128i sum = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + size)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + size)));
+        const uint32_t gen = _mm_movemask_epi8(_mm_cmpgt_epi8(sum, nine));
+        const uint32_t prop = _mm_movemask_epi8(_mm_cmpeq_epi8(sum, nine));
+        const uint32_t carries = resolve_carries(gen, prop, 16, carry);
+        sum = _mm_sub_epi8(sum, expand_mask_sse(carries)); // all ones is -1
+        sum = _mm_sub_epi8(sum, _mm_and_si128(_mm_cmpgt_epi8(sum, nine), ten));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(x + size), sum);
+    }
+    return add_digits_scalar(x, y, size, carry);
+}
+
+SIMD_TARGET("sse4.1")
+udigit sub_digits_sse(udigit *x, const udigit *y, size_t size,
+                      udigit borrow, const bool reverse) noexcept
+{
+    const __m128i zero = _mm_setzero_si128(), ten = _mm_set1_epi8(10);
+    while (size >= 16)
+    {
+        size -= 16;
+        const __m128i vx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + size));
+        const __m128i vy = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + size));
+        __m128i diff = reverse ? _mm_sub_epi8(vy, vx) : _mm_sub_epi8(vx, vy);
+        const uint32_t gen = _mm_movemask_epi8(_mm_cmpgt_epi8(zero, diff));
+        const uint32_t prop = _mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero));
+        const uint32_t borrows = resolve_carries(gen, prop, 16, borrow);
+        diff = _mm_add_epi8(diff, expand_mask_sse(borrows)); // all ones is -1
+        diff = _mm_add_epi8(diff, _mm_and_si128(_mm_cmpgt_epi8(zero, diff), ten));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(x + size), diff);
+    }
+    return sub_digits_scalar(x, y, size, borrow, reverse);
+}
+
+/**
+ * @brief Expand a 32 bit lane mask to bytes of all ones.
+ */
+SIMD_TARGET("avx2")
+inline __m256i expand_mask_avx2(const uint32_t mask) noexcept
+{
+    const __m256i spread = _mm256_shuffle_epi8(
+        _mm256_set1_epi32(static_cast<int>(mask)),
+        _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                         2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3));
+    const __m256i bits = _mm256_set1_epi64x(static_cast<int64_t>(0x8040201008040201ULL));
+    return _mm256_cmpeq_epi8(_mm256_and_si256(spread, bits), bits);
+}
+
+SIMD_TARGET("avx2")
+udigit add_digits_avx2(udigit *x, const udigit *y, size_t size, udigit carry) noexcept
+{
+    const __m256i nine = _mm256_set1_epi8(9), ten = _mm256_set1_epi8(10);
+    while (size >= 32)
+    {
+        size -= 32;
+        __m256i sum = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + size)),
+                                      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y + size)));
+        const uint32_t gen = _mm256_movemask_epi8(_mm256_cmpgt_epi8(sum, nine));
+        const uint32_t prop = _mm256_movemask_epi8(_mm256_cmpeq_epi8(sum, nine));
+        const uint32_t carries = resolve_carries(gen, prop, 32, carry);
+        sum = _mm256_sub_epi8(sum, expand_mask_avx2(carries)); // all ones is -1
+        sum = _mm256_sub_epi8(sum, _mm256_and_si256(_mm256_cmpgt_epi8(sum, nine), ten));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + size), sum);
+    }
+    return add_digits_sse(x, y, size, carry);
+}
+
+SIMD_TARGET("avx2")
+udigit sub_digits_avx2(udigit *x, const udigit *y, size_t size,
+                       udigit borrow, const bool reverse) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256(), ten = _mm256_set1_epi8(10);
+    while (size >= 32)
+    {
+        size -= 32;
+        const __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + size));
+        const __m256i vy = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y + size));
+        __m256i diff = reverse ? _mm256_sub_epi8(vy, vx) : _mm256_sub_epi8(vx, vy);
+        const uint32_t gen = _mm256_movemask_epi8(_mm256_cmpgt_epi8(zero, diff));
+        const uint32_t prop = _mm256_movemask_epi8(_mm256_cmpeq_epi8(diff, zero));
+        const uint32_t borrows = resolve_carries(gen, prop, 32, borrow);
+        diff = _mm256_add_epi8(diff, expand_mask_avx2(borrows)); // all ones is -1
+        diff = _mm256_add_epi8(diff, _mm256_and_si256(_mm256_cmpgt_epi8(zero, diff), ten));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(x + size), diff);
+    }
+    return sub_digits_sse(x, y, size, borrow, reverse);
+}
+
+/**
+ * @brief Detect the instruction sets usable by this process.
+ * @param sse41 receives sse4.1 support.
+ * @param avx2 receives avx2 support (including os saved ymm state).
+ */
+inline void detect_cpu(bool &sse41, bool &avx2) noexcept
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    sse41 = __builtin_cpu_supports("sse4.1");
+    avx2 = __builtin_cpu_supports("avx2");
+#else
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    sse41 = (info[2] >> 19) & 1;
+    const bool osxsave = (info[2] >> 27) & 1;
+    const bool ymm_saved = osxsave && (_xgetbv(0) & 6) == 6;
+    avx2 = false;
+    if (max_leaf >= 7 && ymm_saved)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] >> 5) & 1;
+    }
+#endif
+}
+
+#endif // SIMD_X86
+
+/**
+ * @brief Digit kernels selected for the running cpu.
+ */
+struct digit_kernels
+{
+    udigit (*add)(udigit *, const udigit *, size_t, udigit);
+    udigit (*sub)(udigit *, const udigit *, size_t, udigit, bool);
+};
+
+/**
+ * @brief Get the digit kernels, selected once on first use.
+ */
+inline const digit_kernels &get_kernels() noexcept
+{
+    static const digit_kernels kernels = []() -> digit_kernels
+    {
+#ifdef SIMD_X86
+        bool sse41, avx2;
+        detect_cpu(sse41, avx2);
+        if (avx2)
+            return {add_digits_avx2, sub_digits_avx2};
+        if (sse41)
+            return {add_digits_sse, sub_digits_sse};
+#endif
+        return {add_digits_scalar, sub_digits_scalar};
+    }();
+    return kernels;
+}
+
+/**
+ * @brief Perform digit range addition, x += y.
+ * @param x augend, receives the sum.
+ * @param y addend.
+ * @param size number of digits in both ranges.
+ * @param carry carry into the least significant digit.
+ * @return carry out of the most significant digit.
+ */
+inline udigit add_digits(udigit *x, const udigit *y, const size_t size, const udigit carry = 0)
+{
+    return get_kernels().add(x, y, size, carry);
+}
+
+/**
+ * @brief Perform digit range subtraction, x -= y or x = y - x.
+ * @param x minuend, receives the difference.
+ * @param y subtrahend.
+ * @param size number of digits in both ranges.
+ * @param borrow borrow from the least significant digit.
+ * @param reverse compute y - x instead of x - y.
+ * @return borrow out of the most significant digit.
+ */
+inline udigit sub_digits(udigit *x, const udigit *y, const size_t size,
+                         const udigit borrow = 0, const bool reverse = false)
+{
+    return get_kernels().sub(x, y, size, borrow, reverse);
+}
+
+/**
+ * @brief Propagate a carry into a digit range.
+ * @param x digits, receives the sum.
+ * @param size number of digits.
+ * @param carry carry into the least significant digit.
+ * @return carry out of the most significant digit.
+ */
+inline udigit carry_digits(udigit *x, size_t size, udigit carry) noexcept
+{
+    while (carry && size > 0)
+    {
+        --size;
+        carry = x[size] == 9;
+        x[size] = carry ? 0 : x[size] + 1;
+    }
+    return carry;
+}
+
+/**
+ * @brief Propagate a borrow into a digit range.
+ * @param x digits, receives the difference.
+ * @param size number of digits.
+ * @param borrow borrow from the least significant digit.
+ * @return borrow out of the most significant digit.
+ */
+inline udigit borrow_digits(udigit *x, size_t size, udigit borrow) noexcept
+{
+    while (borrow && size > 0)
+    {
+        --size;
+        borrow = x[size] == 0;
+        x[size] = borrow ? 9 : x[size] - 1;
+    }
+    return borrow;
+}
+
+#endif // SIMD_H
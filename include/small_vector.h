@@ -0,0 +1,338 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief Vector with inline storage for up to N elements.
+ * Elements live inside the object until the vector grows past N,
+ * then they move to the heap (and stay there until destruction).
+ * @tparam T trivially copyable element type.
+ * @tparam N number of inline elements.
+ * @tparam Alloc stateless allocator for the heap buffer.
+ */
+template <typename T, size_t N, typename Alloc = std::allocator<T>>
+class small_vector
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "small_vector elements are moved with memcpy");
+
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+private:
+    T *ptr;
+    size_t len;
+    size_t cap;
+    T buf[N];
+
+    bool is_inline() const noexcept { return ptr == buf; }
+
+    /**
+     * @brief Move the elements to a heap buffer of new_cap elements.
+     */
+    void reallocate(const size_t new_cap)
+    {
+        T *mem = Alloc().allocate(new_cap);
+        if (len)
+            std::memcpy(mem, ptr, len * sizeof(T));
+        if (!is_inline())
+            Alloc().deallocate(ptr, cap);
+        ptr = mem;
+        cap = new_cap;
+    }
+
+    /**
+     * @brief Ensure capacity for size elements, growing geometrically.
+     */
+    void grow(const size_t size)
+    {
+        if (size > cap)
+            reallocate(std::max(size, 2 * cap));
+    }
+
+    /**
+     * @brief Open a gap of count elements at index, elements after it are shifted.
+     * @return pointer to the gap.
+     */
+    T *open_gap(const size_t index, const size_t count)
+    {
+        grow(len + count);
+        T *pos = ptr + index;
+        if (index < len)
+            std::memmove(pos + count, pos, (len - index) * sizeof(T));
+        len += count;
+        return pos;
+    }
+
+    void copy_from(const small_vector &other)
+    {
+        if (other.is_inline() && is_inline())
+        { // a fixed size copy is cheaper than a sized one
+            std::memcpy(buf, other.buf, sizeof(buf));
+            len = other.len;
+            return;
+        }
+        grow(other.len);
+        if (other.len)
+            std::memcpy(ptr, other.ptr, other.len * sizeof(T));
+        len = other.len;
+    }
+
+    void move_from(small_vector &other) noexcept
+    {
+        if (other.is_inline())
+        { // a fixed size copy is cheaper than a sized one
+            std::memcpy(buf, other.buf, sizeof(buf));
+            ptr = buf;
+            cap = N;
+            len = other.len;
+        }
+        else
+        { // steal the heap buffer
+            ptr = other.ptr;
+            len = other.len;
+            cap = other.cap;
+            other.ptr = other.buf;
+            other.cap = N;
+        }
+        other.len = 0;
+    }
+
+    void release() noexcept
+    {
+        if (!is_inline())
+            Alloc().deallocate(ptr, cap);
+        ptr = buf;
+        cap = N;
+    }
+
+public:
+    small_vector() noexcept : ptr(buf), len(0), cap(N) {}
+
+    explicit small_vector(const size_t count, const T &value = T())
+        : ptr(buf), len(0), cap(N)
+    {
+        assign(count, value);
+    }
+
+    template <typename It, typename = typename std::enable_if<
+                               !std::is_integral<It>::value>::type>
+    small_vector(It first, It last) : ptr(buf), len(0), cap(N)
+    {
+        assign(first, last);
+    }
+
+    small_vector(std::initializer_list<T> init) : ptr(buf), len(0), cap(N)
+    {
+        assign(init.begin(), init.end());
+    }
+
+    small_vector(const small_vector &other) : ptr(buf), len(0), cap(N)
+    {
+        copy_from(other);
+    }
+
+    small_vector(small_vector &&other) noexcept : ptr(buf), len(0), cap(N)
+    {
+        move_from(other);
+    }
+
+    ~small_vector() { release(); }
+
+    small_vector &operator=(const small_vector &other)
+    {
+        if (this != &other)
+            copy_from(other);
+        return *this;
+    }
+
+    small_vector &operator=(small_vector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    small_vector &operator=(std::initializer_list<T> init)
+    {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    /* ====================
+     * ELEMENT ACCESS
+     * ==================== */
+    T &operator[](const size_t index) noexcept { return ptr[index]; }
+    const T &operator[](const size_t index) const noexcept { return ptr[index]; }
+    T &front() noexcept { return ptr[0]; }
+    const T &front() const noexcept { return ptr[0]; }
+    T &back() noexcept { return ptr[len - 1]; }
+    const T &back() const noexcept { return ptr[len - 1]; }
+    T *data() noexcept { return ptr; }
+    const T *data() const noexcept { return ptr; }
+
+    /* ====================
+     * ITERATORS
+     * ==================== */
+    iterator begin() noexcept { return ptr; }
+    const_iterator begin() const noexcept { return ptr; }
+    const_iterator cbegin() const noexcept { return ptr; }
+    iterator end() noexcept { return ptr + len; }
+    const_iterator end() const noexcept { return ptr + len; }
+    const_iterator cend() const noexcept { return ptr + len; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    /* ====================
+     * CAPACITY
+     * ==================== */
+    bool empty() const noexcept { return len == 0; }
+    size_t size() const noexcept { return len; }
+    size_t capacity() const noexcept { return cap; }
+
+    void reserve(const size_t size)
+    {
+        if (size > cap)
+            reallocate(size);
+    }
+
+    /* ====================
+     * MODIFIERS
+     * ==================== */
+    void clear() noexcept { len = 0; }
+
+    void resize(const size_t size, const T &value = T())
+    {
+        if (size > len)
+        {
+            const T copy = value;
+            grow(size);
+            std::fill(ptr + len, ptr + size, copy);
+        }
+        len = size;
+    }
+
+    void assign(const size_t count, const T &value)
+    {
+        const T copy = value;
+        len = 0;
+        grow(count);
+        std::fill(ptr, ptr + count, copy);
+        len = count;
+    }
+
+    template <typename It, typename = typename std::enable_if<
+                               !std::is_integral<It>::value>::type>
+    void assign(It first, It last)
+    {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count > cap)
+        { // the source may alias the current buffer
+            small_vector tmp;
+            tmp.reallocate(count);
+            std::copy(first, last, tmp.ptr);
+            tmp.len = count;
+            *this = std::move(tmp);
+            return;
+        }
+        std::copy(first, last, ptr); // forward copy tolerates aliasing
+        len = count;
+    }
+
+    void push_back(const T &value)
+    {
+        const T copy = value;
+        grow(len + 1);
+        ptr[len++] = copy;
+    }
+
+    template <typename... Args>
+    void emplace_back(Args &&...args)
+    {
+        push_back(T(std::forward<Args>(args)...));
+    }
+
+    void pop_back() noexcept { --len; }
+
+    iterator insert(const_iterator pos, const T &value)
+    {
+        return insert(pos, 1U, value);
+    }
+
+    iterator insert(const_iterator pos, const size_t count, const T &value)
+    {
+        const T copy = value;
+        T *gap = open_gap(static_cast<size_t>(pos - ptr), count);
+        std::fill(gap, gap + count, copy);
+        return gap;
+    }
+
+    template <typename It, typename = typename std::enable_if<
+                               !std::is_integral<It>::value>::type>
+    iterator insert(const_iterator pos, It first, It last)
+    {
+        const size_t index = static_cast<size_t>(pos - ptr);
+        const small_vector src(first, last); // the source may alias this
+        T *gap = open_gap(index, src.len);
+        if (src.len)
+            std::memcpy(gap, src.ptr, src.len * sizeof(T));
+        return gap;
+    }
+
+    iterator erase(const_iterator pos) noexcept
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept
+    {
+        T *dst = ptr + (first - ptr);
+        const size_t tail = static_cast<size_t>(end() - last);
+        if (first != last && tail)
+            std::memmove(dst, last, tail * sizeof(T));
+        len -= static_cast<size_t>(last - first);
+        return dst;
+    }
+
+    void swap(small_vector &other) noexcept
+    {
+        small_vector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+};
+
+template <typename T, size_t N, typename A>
+inline bool operator==(const small_vector<T, N, A> &x, const small_vector<T, N, A> &y) noexcept
+{
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+template <typename T, size_t N, typename A>
+inline bool operator!=(const small_vector<T, N, A> &x, const small_vector<T, N, A> &y) noexcept
+{
+    return !(x == y);
+}
+
+#endif // SMALL_VECTOR_H
@@ -2,22 +2,39 @@
 #define UTILS_H
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include "alloc.h"
+#include "small_vector.h"
 
 typedef uint_fast8_t udigit;
+typedef uint32_t limb;  // 9 decimal digits
+typedef uint64_t dlimb; // holds the product of two limbs
+
+constexpr limb LIMB_BASE = 1000000000U;
+constexpr size_t LIMB_DIGITS = 9U;
+
+// integer digits that always fit a machine word, sums included (2 * 10^18 < 2^63).
+constexpr size_t MACHINE_DIGITS = 18U;
+// 10^MACHINE_DIGITS, machine integer operands below it take the small kernels.
+constexpr uint64_t MACHINE_LIMIT = 1000000000000000000ULL;
+// digits stored inline before a digit vector moves to the heap.
+constexpr size_t INLINE_DIGITS = 32U;
+typedef small_vector<udigit, INLINE_DIGITS, pool_allocator<udigit>> digit_vector;
+typedef std::vector<limb, pool_allocator<limb>> limb_vector;
 
 /**
  * @brief Remove leading zeros.
  * @attention if vec is empty, a zero is added.
  * @param vec The vector of integers to modify.
  */
-void lstrip_zeros(std::vector<udigit> &vec) noexcept
+void lstrip_zeros(digit_vector &vec) noexcept
 {
     if (vec.empty())
     { // a zero should be there
         vec.push_back(0);
         return;
     }
-    std::vector<udigit>::iterator it;
+    digit_vector::iterator it;
     it = vec.begin();
     while (it != vec.end() && *it == 0)
         ++it;
@@ -31,14 +48,14 @@ void lstrip_zeros(std::vector<udigit> &vec) noexcept
  * @attention if vec is empty, a zero is added.
  * @param vec The vector of integers to modify.
  */
-void rstrip_zeros(std::vector<udigit> &vec) noexcept
+void rstrip_zeros(digit_vector &vec) noexcept
 {
     if (vec.empty())
     { // a zero should be there
         vec.push_back(0);
         return;
     }
-    std::vector<udigit>::reverse_iterator it;
+    digit_vector::reverse_iterator it;
     it = vec.rbegin();
     while (it != vec.rend() && *it == 0)
         ++it;
@@ -55,7 +72,7 @@ void rstrip_zeros(std::vector<udigit> &vec) noexcept
  * @param y The second vector of integers to compare.
  * @return 0 if x == y, -1 if x < y, 1 if x > y.
  */
-const short cmp(const std::vector<udigit> &x, const std::vector<udigit> &y) noexcept
+short cmp(const digit_vector &x, const digit_vector &y) noexcept
 {
     const size_t s1 = x.size();
     const size_t s2 = y.size();
@@ -82,7 +99,7 @@ const short cmp(const std::vector<udigit> &x, const std::vector<udigit> &y) noex
  * @param y The second vector of integers to compare.
  * @return 0 if x == y, -1 if x < y, 1 if x > y.
  */
-const short fcmp(const std::vector<udigit> &x, const std::vector<udigit> &y) noexcept
+short fcmp(const digit_vector &x, const digit_vector &y) noexcept
 {
     const size_t size = std::max(x.size(), y.size());
     auto xi = x.begin();
@@ -107,8 +124,8 @@ const short fcmp(const std::vector<udigit> &x, const std::vector<udigit> &y) noe
  * @param fy fraction part.
  * @return 0 if equal, -1 if lesser, 1 if greater.
  */
-inline const short cmp(const std::vector<udigit> &x, const std::vector<udigit> &fx,
-                       const std::vector<udigit> &y, const std::vector<udigit> &fy) noexcept
+inline short cmp(const digit_vector &x, const digit_vector &fx,
+                       const digit_vector &y, const digit_vector &fy) noexcept
 {
     const short icmp = cmp(x, y);
     return (icmp == 0) ? fcmp(fx, fy) : icmp;
@@ -119,9 +136,9 @@ inline const short cmp(const std::vector<udigit> &x, const std::vector<udigit> &
  * @param num_str string of ascii chars 0-9.
  * @return vector of integers 0-9.
  */
-const std::vector<udigit> convert(const std::string &num_str)
+const digit_vector convert(const std::string &num_str)
 {
-    std::vector<udigit> result;
+    digit_vector result;
     result.reserve(num_str.size());
     for (size_t i = 0; i < num_str.size(); ++i)
         result.emplace_back(num_str[i] - '0');
@@ -133,7 +150,7 @@ const std::vector<udigit> convert(const std::string &num_str)
  * @param vec vector of integers 0-9.
  * @return string of ascii chars 0-9.
  */
-const std::string convert(const std::vector<udigit> &vec)
+const std::string convert(const digit_vector &vec)
 {
     std::string result;
     result.reserve(vec.size());
@@ -142,82 +159,287 @@ const std::string convert(const std::vector<udigit> &vec)
     return result;
 }
 
+/**
+ * @brief Convert vector of integers to a machine word.
+ * @param vec vector of integers 0-9 (at most 19 digits).
+ * @return value of the digits.
+ */
+inline uint64_t to_machine(const digit_vector &vec) noexcept
+{
+    uint64_t num = 0;
+    for (const udigit *ptr = vec.data(), *end = ptr + vec.size(); ptr != end; ++ptr)
+        num = num * 10 + *ptr;
+    return num;
+}
+
+/**
+ * @brief Convert a machine word to vector of integers.
+ * @param num value to convert.
+ * @param vec vector to store the digits.
+ */
+void from_machine(uint64_t num, digit_vector &vec)
+{
+    udigit buf[20];
+    udigit *end = buf + 20, *ptr = end;
+    while (num >= LIMB_BASE)
+    { // peel 9 digits at a time with 32 bit arithmetic
+        limb low = static_cast<limb>(num % LIMB_BASE);
+        num /= LIMB_BASE;
+        for (size_t i = 0; i < LIMB_DIGITS; ++i, low /= 10)
+            *--ptr = low % 10;
+    }
+    limb top = static_cast<limb>(num);
+    do
+    {
+        *--ptr = top % 10;
+        top /= 10;
+    } while (top);
+    vec.assign(ptr, end);
+}
+
 /**
  * @brief Convert number to vector of integers.
  * @param num unsigned long long.
  * @return vector of integers 0-9.
  */
-const std::vector<udigit> convert(uint_fast64_t num)
+const digit_vector convert(const uint_fast64_t num)
+{
+    digit_vector result;
+    from_machine(num, result);
+    return result;
+}
+
+/**
+ * @brief Get the magnitude of a signed machine integer.
+ * @param num signed integer, INT64_MIN included.
+ * @return absolute value of num.
+ */
+inline uint64_t machine_abs(const int_fast64_t num) noexcept
+{
+    return num < 0 ? 0 - static_cast<uint64_t>(num) : static_cast<uint64_t>(num);
+}
+
+#ifdef __SIZEOF_INT128__
+/**
+ * @brief Convert a double machine word to vector of integers.
+ * @param num value to convert (less than 10^36).
+ * @param vec vector to store the digits.
+ */
+void from_machine(unsigned __int128 num, digit_vector &vec)
 {
-    if (num < 10)
-        return {static_cast<udigit>(num)};
+    if (num <= UINT64_MAX)
+        return from_machine(static_cast<uint64_t>(num), vec);
+    from_machine(static_cast<uint64_t>(num / MACHINE_LIMIT), vec);
+    uint64_t low = static_cast<uint64_t>(num % MACHINE_LIMIT);
+    const size_t size = vec.size();
+    vec.resize(size + 18);
+    for (size_t i = size + 18; i > size; --i, low /= 10)
+        vec[i - 1] = low % 10;
+}
+#endif
 
-    size_t size = 2;
-    uint_fast64_t tens = 100;
-    while (tens < num)
-    { // calculate int size
-        ++size;
-        tens *= 10;
+/**
+ * @brief Pack decimal digits into base 10^9 limbs.
+ * @param vec vector of integers 0-9 (most significant first).
+ * @return vector of limbs (least significant first),
+ * empty if the value is zero.
+ */
+const limb_vector to_limbs(const digit_vector &vec)
+{
+    limb_vector result;
+    result.reserve(vec.size() / LIMB_DIGITS + 1);
+    const udigit *begin = vec.data();
+    const udigit *ptr = begin + vec.size();
+    while (ptr != begin)
+    {
+        const udigit *first = (static_cast<size_t>(ptr - begin) > LIMB_DIGITS)
+                                  ? ptr - LIMB_DIGITS
+                                  : begin;
+        limb value = 0;
+        for (const udigit *it = first; it != ptr; ++it)
+            value = value * 10 + *it;
+        result.push_back(value);
+        ptr = first;
     }
-    std::vector<udigit> result;
-    result.reserve(size);
-    while (num > 0)
+    while (!result.empty() && result.back() == 0)
+        result.pop_back(); // strip high zero limbs
+    return result;
+}
+
+/**
+ * @brief Unpack base 10^9 limbs into decimal digits.
+ * @param limbs vector of limbs (least significant first).
+ * @return vector of integers 0-9 without leading zeros.
+ */
+const digit_vector from_limbs(const limb_vector &limbs)
+{
+    size_t size = limbs.size();
+    while (size && limbs[size - 1] == 0)
+        --size; // skip high zero limbs
+    if (size == 0)
+        return {0};
+
+    limb top = limbs[size - 1];
+    size_t top_size = 1;
+    for (limb tens = 10; tens <= top && top_size < LIMB_DIGITS; tens *= 10)
+        ++top_size;
+
+    digit_vector result(top_size + (size - 1) * LIMB_DIGITS);
+    udigit *ptr = result.data() + result.size();
+    for (size_t i = 0; i < size - 1; ++i)
     {
-        result.insert(result.begin(), num % 10);
-        num /= 10;
+        limb value = limbs[i];
+        for (size_t j = 0; j < LIMB_DIGITS; ++j, value /= 10)
+            *--ptr = value % 10;
     }
+    for (; top_size; --top_size, top /= 10)
+        *--ptr = top % 10;
     return result;
 }
 
 /**
- * Convert int/float represented string to vector of integers.
+ * @brief Split fixed point digits into integer and fraction parts.
+ * @param value vector of integers 0-9 holding the number * 10^frac_size.
+ * @param frac_size number of fraction digits.
+ * @param integer vector to store the integer part.
+ * @param fraction vector to store the fraction part.
+ */
+void split_digits(digit_vector value, const size_t frac_size,
+                  digit_vector &integer, digit_vector &fraction)
+{
+    if (value.size() <= frac_size) // pad to keep an integer digit
+        value.insert(value.begin(), frac_size - value.size() + 1, 0);
+
+    const size_t dec_point = value.size() - frac_size;
+    integer.assign(value.begin(), value.begin() + dec_point);
+    fraction.assign(value.begin() + dec_point, value.end());
+    lstrip_zeros(integer);  // normalize integer
+    rstrip_zeros(fraction); // normalize fraction
+}
+
+/**
+ * @brief Check if a number is an integer of at most MACHINE_DIGITS digits.
+ * @param x magnitude * 10^fx.
+ * @param fx number of fraction digits.
+ * @param * vector of limbs.
+ */
+inline bool fits_machine(const limb_vector &x, const size_t fx) noexcept
+{
+    return fx == 0 && x.size() <= MACHINE_DIGITS / LIMB_DIGITS;
+}
+
+/**
+ * @brief Convert limbs to a machine word.
+ * @param x vector of limbs (at most two limbs).
+ * @return value of the limbs.
+ */
+inline uint64_t to_machine(const limb_vector &x) noexcept
+{
+    uint64_t num = 0;
+    for (size_t i = x.size(); i > 0; --i)
+        num = num * LIMB_BASE + x[i - 1];
+    return num;
+}
+
+/**
+ * @brief Convert a machine word to limbs.
+ * @param num value to convert.
+ * @param x vector to store the limbs.
+ */
+void from_machine(uint64_t num, limb_vector &x)
+{
+    x.clear();
+    for (; num; num /= LIMB_BASE)
+        x.push_back(static_cast<limb>(num % LIMB_BASE));
+}
+
+#ifdef __SIZEOF_INT128__
+/**
+ * @brief Convert a double machine word to limbs.
+ * @param num value to convert.
+ * @param x vector to store the limbs.
+ */
+void from_machine(unsigned __int128 num, limb_vector &x)
+{
+    x.clear();
+    for (; num; num /= LIMB_BASE)
+        x.push_back(static_cast<limb>(num % LIMB_BASE));
+}
+#endif
+
+/**
+ * @brief Convert limbs to a string of digits.
+ * @param x vector of limbs (least significant first).
+ * @param width minimum number of digits, padded with leading zeros.
+ * @return string of ascii chars 0-9.
+ */
+const std::string limbs_str(const limb_vector &x, const size_t width = 1)
+{
+    std::string result(std::max(width, x.size() * LIMB_DIGITS), '0');
+    char *ptr = &result[0] + result.size();
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        limb value = x[i];
+        for (size_t j = 0; j < LIMB_DIGITS; ++j, value /= 10)
+            *--ptr = static_cast<char>('0' + value % 10);
+    }
+    const size_t zeros = std::min(result.find_first_not_of('0'),
+                                  result.size() - std::min(width, result.size()));
+    result.erase(0, zeros); // drop the padding of the top limb
+    return result;
+}
+
+/**
+ * Convert int/float represented string to fixed point limbs.
  *
  * @param num_str string of digits to be converted.
- * @param integer vector to store the integer part of the float.
- * @param fraction vector to store the fractional part of the float.
+ * @param mag vector of limbs to store the magnitude * 10^frac.
+ * @param frac variable to store the number of fraction digits.
  * @return A boolean indicating the sign of the float.
  * @throws std::invalid_argument, If the string contains non-digit characters.
  */
-bool convert_num_str(const std::string &num_str,
-                     std::vector<udigit> &integer, std::vector<udigit> &fraction)
+bool convert_num_str(const std::string &num_str, limb_vector &mag, size_t &frac)
 {
-    size_t size = num_str.size();
-    if (size == 0) // if string is empty
+    if (num_str.empty())
         throw std::invalid_argument("Invalid number");
-    const size_t pos = num_str.find('.');
-    size_t int_size = (pos == std::string::npos) ? size : pos;
-    const char *ptr = num_str.data();
-    const bool sign = *ptr == '-';
-    if (sign || *ptr == '+')
-    {
-        ++ptr;
-        --size;
-        --int_size;
-    }
-    const char *end = ptr + int_size;
-    integer.reserve(int_size);
-    for (; ptr != end; ++ptr)
-    {
-        if (*ptr < 48 || *ptr > 58) // if not in 0-9 range
-            throw std::invalid_argument("Invalid number");
-        integer.emplace_back(*ptr - '0');
-    }
-    const size_t frac_size = size - int_size;
-    if (frac_size == 0)
-    { // no fraction
-        fraction.assign(1, 0);
-        return sign;
-    }
-    const char *fend = ptr + frac_size;
-    fraction.reserve(frac_size);
-    for (++ptr; ptr != fend; ++ptr)
-    {
-        if (*ptr < 48 || *ptr > 58) // if not in 0-9 range
+    const char *begin = num_str.data();
+    const char *end = begin + num_str.size();
+    const bool sign = *begin == '-';
+    if (sign || *begin == '+')
+        ++begin;
+    const char *point = std::find(begin, end, '.');
+    for (const char *ptr = begin; ptr != end; ++ptr)
+        if ((*ptr < '0' || *ptr > '9') && ptr != point)
             throw std::invalid_argument("Invalid number");
-        fraction.emplace_back(*ptr - '0');
+
+    const char *first = begin; // normalize integer
+    while (first != point && *first == '0')
+        ++first;
+    const char *last = end; // normalize fraction
+    if (point != end)
+        while (last != point + 1 && *(last - 1) == '0')
+            --last;
+    frac = point != end ? static_cast<size_t>(last - point - 1) : 0;
+
+    mag.clear();
+    mag.reserve((static_cast<size_t>(point - first) + frac) / LIMB_DIGITS + 1);
+    limb value = 0, scale = 1;
+    for (const char *ptr = last; ptr != first; --ptr)
+    { // pack 9 digits per limb from the least significant digit
+        if (ptr - 1 == point)
+            continue;
+        value += (*(ptr - 1) - '0') * scale;
+        scale *= 10;
+        if (scale == LIMB_BASE)
+        {
+            mag.push_back(value);
+            value = 0, scale = 1;
+        }
     }
-    lstrip_zeros(integer);  // normalize integer
-    rstrip_zeros(fraction); // normalize fraction
+    if (value)
+        mag.push_back(value);
+    while (!mag.empty() && mag.back() == 0)
+        mag.pop_back(); // strip high zero limbs
     return sign;
 }
 
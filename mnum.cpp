@@ -1,21 +1,75 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include "include/mnum.h"
+#include "include/divisor.h"
 
-const mnum cast(const pybind11::handle &handle)
+const mnum from_pylong(const pybind11::handle &handle)
+{
+     int overflow;
+     const long long n = PyLong_AsLongLongAndOverflow(handle.ptr(), &overflow);
+     if (n == -1 && PyErr_Occurred())
+          throw pybind11::error_already_set();
+     if (!overflow)
+          return mnum(n);
+     // Convert the magnitude through its little endian bytes
+     const pybind11::object magnitude =
+         pybind11::reinterpret_steal<pybind11::object>(PyNumber_Absolute(handle.ptr()));
+     if (!magnitude)
+          throw pybind11::error_already_set();
+     const size_t words = (magnitude.attr("bit_length")().cast<size_t>() + 31) / 32;
+     const std::string bytes =
+         magnitude.attr("to_bytes")(words * 4, "little").cast<std::string>();
+     std::vector<uint32_t> x(words);
+     for (size_t i = 0; i < words; ++i)
+     {
+          const unsigned char *b = reinterpret_cast<const unsigned char *>(bytes.data()) + 4 * i;
+          x[i] = b[0] | (b[1] << 8) | (b[2] << 16) | (static_cast<uint32_t>(b[3]) << 24);
+     }
+     return mnum(from_binary(x), 0, overflow < 0);
+}
+
+pybind11::object limbs_to_pylong(const limb_vector &x, const size_t lo, const size_t hi,
+                                 std::vector<pybind11::object> &powers)
+{
+     if (hi - lo <= 2)
+     { // fits unsigned long long
+          unsigned long long n = 0;
+          for (size_t i = hi; i > lo; --i)
+               n = n * LIMB_BASE + x[i - 1];
+          return pybind11::reinterpret_steal<pybind11::object>(PyLong_FromUnsignedLongLong(n));
+     }
+     size_t level = 0; // split at the largest power of two below size
+     while ((static_cast<size_t>(2) << level) < hi - lo)
+          ++level;
+     const size_t half = static_cast<size_t>(1) << level;
+     while (powers.size() <= level)
+          powers.push_back(powers.back() * powers.back());
+     const pybind11::object high = limbs_to_pylong(x, lo + half, hi, powers);
+     return high * powers[level] + limbs_to_pylong(x, lo, lo + half, powers);
+}
+
+pybind11::object to_pylong(const mnum &self)
+{
+     limb_vector x, fx;
+     lsplit(self.mag, self.frac, x, fx);
+     std::vector<pybind11::object> powers(1, pybind11::int_(LIMB_BASE)); // 10^(9 * 2^i)
+     pybind11::object n = limbs_to_pylong(x, 0, x.size(), powers);
+     if (self.sign && !x.empty())
+          return pybind11::reinterpret_steal<pybind11::object>(PyNumber_Negative(n.ptr()));
+     return n;
+}
+
+mnum cast(const pybind11::handle &handle)
 {
      if (pybind11::isinstance<mnum>(handle))
      {
           // Handle is already a mint object
-          return handle.cast<mnum>();
+          return handle.cast<const mnum &>();
      }
      if (PyLong_Check(handle.ptr()))
      {
-          // Convert Python int to C++ long long and then to mint
-          const long long n = PyLong_AsLongLong(handle.ptr());
-          if (n == -1 && PyErr_Occurred())
-               throw pybind11::error_already_set();
-          return mnum(n);
+          // Convert Python int of any size to mint
+          return from_pylong(handle);
      }
      if (PyUnicode_Check(handle.ptr()))
      {
@@ -23,23 +77,41 @@ const mnum cast(const pybind11::handle &handle)
           const std::string s = PyUnicode_AsUTF8(handle.ptr());
           return mnum(s);
      }
-     if (pybind11::isinstance<pybind11::float_>(handle))
+     if (PyFloat_Check(handle.ptr()))
      {
-          try
-          {
-               // get a string representation of the object
-               std::string str = pybind11::str(handle.ptr());
-               return mnum(str);
-          }
-          catch(const std::invalid_argument&)
-          {
-               throw pybind11::value_error("can't convert float with scientific notation");
-          }
+          // Convert Python float to the shortest round trip digits
+          return mnum::from_double(PyFloat_AS_DOUBLE(handle.ptr()));
      }
      // Raise TypeError for unsupported types
      throw pybind11::type_error("unsupported type, expected int, float, str or mnum");
 }
 
+/**
+ * Operand of a binary operation, mnum objects are borrowed
+ * by reference, other types are converted into owned storage.
+ */
+class operand
+{
+     mnum owned;
+     const mnum *ptr;
+
+public:
+     explicit operand(const pybind11::handle &handle) : owned(0)
+     {
+          if (pybind11::isinstance<mnum>(handle))
+               ptr = &handle.cast<const mnum &>();
+          else
+          {
+               owned = cast(handle);
+               ptr = &owned;
+          }
+     }
+     operand(const operand &) = delete;
+     operand &operator=(const operand &) = delete;
+
+     operator const mnum &() const noexcept { return *ptr; }
+};
+
 const size_t check_index(const mnum &self, const int_fast64_t &index)
 {
      const size_t size = self.size();
@@ -49,6 +121,14 @@ const size_t check_index(const mnum &self, const int_fast64_t &index)
      return idx;
 }
 
+// single digit number carrying the given sign
+mnum digit_mnum(const udigit digit, const bool sign)
+{
+     mnum m(static_cast<int_fast64_t>(digit));
+     m.sign = sign;
+     return m;
+}
+
 udigit to_digit(const pybind11::handle &handle, bool &sign)
 {
      if (PyLong_Check(handle.ptr()))
@@ -64,13 +144,13 @@ udigit to_digit(const pybind11::handle &handle, bool &sign)
      }
      if (pybind11::isinstance<mnum>(handle))
      {
-          const mnum m = handle.cast<mnum>();
-          if (!(m.fraction.size() == 1 && m.fraction[0] == 0))
+          const mnum &m = handle.cast<const mnum &>();
+          if (m.frac)
                throw pybind11::value_error("mnum must be non-fraction");
-          if (m.integer.size() != 1)
+          if (m.int_size() != 1)
                throw pybind11::value_error("mnum must be single digit");
           sign = m.sign;
-          return static_cast<udigit>(m.integer[0]);
+          return m[0];
      }
      if (PyLong_Check(handle.attr("__int__")().ptr()))
      {
@@ -84,6 +164,302 @@ udigit to_digit(const pybind11::handle &handle, bool &sign)
      throw pybind11::type_error("unsupported type, expected int or mnum");
 }
 
+const size_t to_precision(const pybind11::handle &handle)
+{
+     if (handle.is_none())
+          return mnum::div_precision(); // use thread's context
+     const long long n = handle.cast<long long>();
+     if (n < 0)
+          throw pybind11::value_error("precision must be non-negative");
+     return static_cast<size_t>(n);
+}
+
+/* =======================================================*
+ *                 NUMBER PROTOCOL SLOTS                  *
+   =======================================================*/
+
+// the mnum type object, set when the slots are installed.
+PyTypeObject *mnum_type = nullptr;
+
+inline mnum *mnum_ptr(PyObject *obj)
+{
+     return reinterpret_cast<pybind11::detail::instance *>(obj)
+         ->get_value_and_holder()
+         .value_ptr<mnum>();
+}
+
+/**
+ * Resolve an operand of a number slot, mnum objects are borrowed,
+ * int, float and str are converted into storage.
+ * @return nullptr if the type is not supported (NotImplemented).
+ */
+const mnum *slot_operand(PyObject *obj, mnum &storage)
+{
+     if (PyObject_TypeCheck(obj, mnum_type))
+          return mnum_ptr(obj);
+     if (PyLong_Check(obj))
+     {
+          int overflow;
+          const long long n = PyLong_AsLongLongAndOverflow(obj, &overflow);
+          if (n == -1 && PyErr_Occurred())
+               throw pybind11::error_already_set();
+          storage = overflow ? from_pylong(obj) : mnum(n);
+          return &storage;
+     }
+     if (PyFloat_Check(obj))
+     {
+          storage = mnum::from_double(PyFloat_AS_DOUBLE(obj));
+          return &storage;
+     }
+     if (PyUnicode_Check(obj))
+     {
+          storage = cast(obj);
+          return &storage;
+     }
+     return nullptr;
+}
+
+/**
+ * Run a slot body, translating C++ exceptions to Python errors.
+ */
+template <typename F>
+PyObject *slot_call(F body) noexcept
+{
+     try
+     {
+          return body();
+     }
+     catch (pybind11::error_already_set &e)
+     {
+          e.restore();
+     }
+     catch (pybind11::builtin_exception &e)
+     {
+          e.set_error();
+     }
+     catch (const std::domain_error &e)
+     {
+          PyErr_SetString(PyExc_ZeroDivisionError, e.what());
+     }
+     catch (const std::invalid_argument &e)
+     {
+          PyErr_SetString(PyExc_ValueError, e.what());
+     }
+     catch (const std::overflow_error &e)
+     {
+          PyErr_SetString(PyExc_OverflowError, e.what());
+     }
+     catch (const std::bad_alloc &)
+     {
+          PyErr_NoMemory();
+     }
+     catch (const std::exception &e)
+     {
+          PyErr_SetString(PyExc_RuntimeError, e.what());
+     }
+     return nullptr;
+}
+
+/**
+ * Read a machine sized Python int without raising.
+ * @return false if obj is not an int or does not fit.
+ */
+bool small_int(PyObject *obj, int_fast64_t &value)
+{
+     if (!PyLong_Check(obj))
+          return false;
+     int overflow;
+     value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+     if (value == -1 && PyErr_Occurred())
+          throw pybind11::error_already_set();
+     return !overflow;
+}
+
+// slot operations, right operands are mnum or machine integers
+struct add_op
+{
+     template <typename T>
+     mnum operator()(const mnum &x, const T &y) const { return x + y; }
+};
+struct sub_op
+{
+     template <typename T>
+     mnum operator()(const mnum &x, const T &y) const { return x - y; }
+};
+struct mul_op
+{
+     template <typename T>
+     mnum operator()(const mnum &x, const T &y) const { return x * y; }
+};
+struct mod_op
+{
+     template <typename T>
+     mnum operator()(const mnum &x, const T &y) const { return x % y; }
+};
+struct floor_div_op
+{
+     template <typename T>
+     mnum operator()(const mnum &x, const T &y) const { return x.floor_div(y); }
+};
+struct true_div_op
+{
+     template <typename T>
+     mnum operator()(const mnum &x, const T &y) const { return x / y; }
+};
+struct iadd_op
+{
+     template <typename T>
+     void operator()(mnum &x, const T &y) const { x += y; }
+};
+struct isub_op
+{
+     template <typename T>
+     void operator()(mnum &x, const T &y) const { x -= y; }
+};
+struct imul_op
+{
+     template <typename T>
+     void operator()(mnum &x, const T &y) const { x *= y; }
+};
+struct imod_op
+{
+     template <typename T>
+     void operator()(mnum &x, const T &y) const { x %= y; }
+};
+struct ifloor_div_op
+{
+     template <typename T>
+     void operator()(mnum &x, const T &y) const { x.ifloor_div(y); }
+};
+struct itrue_div_op
+{
+     template <typename T>
+     void operator()(mnum &x, const T &y) const { x /= y; }
+};
+
+template <typename Op>
+PyObject *binary_slot(PyObject *x, PyObject *y) noexcept
+{
+     return slot_call([&]() -> PyObject *
+     {
+          int_fast64_t n;
+          if (PyObject_TypeCheck(x, mnum_type) && small_int(y, n))
+               return pybind11::cast(Op()(*mnum_ptr(x), n)).release().ptr();
+          mnum xs(0), ys(0);
+          const mnum *px = slot_operand(x, xs);
+          const mnum *py = px ? slot_operand(y, ys) : nullptr;
+          if (!py)
+               Py_RETURN_NOTIMPLEMENTED;
+          return pybind11::cast(Op()(*px, *py)).release().ptr();
+     });
+}
+
+template <typename Op>
+PyObject *inplace_slot(PyObject *x, PyObject *y) noexcept
+{
+     return slot_call([&]() -> PyObject *
+     {
+          if (!PyObject_TypeCheck(x, mnum_type))
+               Py_RETURN_NOTIMPLEMENTED;
+          int_fast64_t n;
+          if (small_int(y, n))
+               Op()(*mnum_ptr(x), n);
+          else
+          {
+               mnum ys(0);
+               const mnum *py = slot_operand(y, ys);
+               if (!py)
+                    Py_RETURN_NOTIMPLEMENTED;
+               Op()(*mnum_ptr(x), *py);
+          }
+          Py_INCREF(x); // the same object is the result
+          return x;
+     });
+}
+
+template <typename Op>
+PyObject *unary_slot(PyObject *x) noexcept
+{
+     return slot_call([&]() -> PyObject *
+          { return pybind11::cast(Op()(*mnum_ptr(x))).release().ptr(); });
+}
+
+struct neg_op
+{
+     mnum operator()(const mnum &x) const { return -x; }
+};
+struct pos_op
+{
+     mnum operator()(const mnum &x) const { return +x; }
+};
+struct abs_op
+{
+     mnum operator()(const mnum &x) const { return x.abs(); }
+};
+
+template <typename T>
+PyObject *compare(const mnum &x, const T &y, const int op)
+{
+     switch (op)
+     {
+     case Py_EQ:
+          return PyBool_FromLong(x == y);
+     case Py_NE:
+          return PyBool_FromLong(x != y);
+     case Py_LT:
+          return PyBool_FromLong(x < y);
+     case Py_LE:
+          return PyBool_FromLong(x <= y);
+     case Py_GT:
+          return PyBool_FromLong(x > y);
+     default:
+          return PyBool_FromLong(x >= y);
+     }
+}
+
+PyObject *mnum_richcompare(PyObject *x, PyObject *y, const int op) noexcept
+{
+     return slot_call([&]() -> PyObject *
+     {
+          int_fast64_t n;
+          if (small_int(y, n))
+               return compare(*mnum_ptr(x), n, op);
+          mnum ys(0);
+          const mnum *py = slot_operand(y, ys);
+          if (!py)
+               Py_RETURN_NOTIMPLEMENTED;
+          return compare(*mnum_ptr(x), *py, op);
+     });
+}
+
+/**
+ * Point the arithmetic and comparison slots of the mnum type
+ * at direct implementations, bypassing the pybind11 dispatcher.
+ * The bound dunder methods stay available for explicit calls.
+ */
+void install_number_slots(const pybind11::handle &cls)
+{
+     mnum_type = reinterpret_cast<PyTypeObject *>(cls.ptr());
+     PyNumberMethods *nb = mnum_type->tp_as_number;
+     nb->nb_add = binary_slot<add_op>;
+     nb->nb_subtract = binary_slot<sub_op>;
+     nb->nb_multiply = binary_slot<mul_op>;
+     nb->nb_remainder = binary_slot<mod_op>;
+     nb->nb_floor_divide = binary_slot<floor_div_op>;
+     nb->nb_true_divide = binary_slot<true_div_op>;
+     nb->nb_inplace_add = inplace_slot<iadd_op>;
+     nb->nb_inplace_subtract = inplace_slot<isub_op>;
+     nb->nb_inplace_multiply = inplace_slot<imul_op>;
+     nb->nb_inplace_remainder = inplace_slot<imod_op>;
+     nb->nb_inplace_floor_divide = inplace_slot<ifloor_div_op>;
+     nb->nb_inplace_true_divide = inplace_slot<itrue_div_op>;
+     nb->nb_negative = unary_slot<neg_op>;
+     nb->nb_positive = unary_slot<pos_op>;
+     nb->nb_absolute = unary_slot<abs_op>;
+     mnum_type->tp_richcompare = mnum_richcompare;
+     PyType_Modified(mnum_type);
+}
+
 namespace py = pybind11;
 
 PYBIND11_MODULE(mnum, m)
@@ -92,49 +468,34 @@ PYBIND11_MODULE(mnum, m)
          .def(py::init([](const py::handle& handle)
                { return mnum(cast(handle)); }))
          .def("__bool__", [](const mnum &self) -> bool
-              { return !(self.integer.size() == 1 && self.integer[0] == 0 &&
-                       self.fraction.size() == 1 && self.fraction[0] == 0);})
+              { return !self.is_zero(); })
          .def("__eq__", [](const mnum &self, const py::handle &other) -> bool
-              { return self == cast(other); })
+              { return self == operand(other); })
          .def("__ne__", [](const mnum &self, const py::handle &other) -> bool
-              { return self != cast(other); })
+              { return self != operand(other); })
          .def("__lt__", [](const mnum &self, const py::handle &other) -> bool
-              { return self < cast(other); })
+              { return self < operand(other); })
          .def("__le__", [](const mnum &self, const py::handle &other) -> bool
-              { return self <= cast(other); })
+              { return self <= operand(other); })
          .def("__gt__", [](const mnum &self, const py::handle &other) -> bool
-              { return self > cast(other); })
+              { return self > operand(other); })
          .def("__ge__", [](const mnum &self, const py::handle &other) -> bool
-              { return self >= cast(other); })
+              { return self >= operand(other); })
          .def("__contains__", [](const mnum &self, const py::handle &other) -> bool
-              { return self.contains(cast(other)); })
+              { return self.contains(operand(other)); })
          .def("__pos__", [](const mnum &self) -> mnum
               { return +self; })
          .def("__neg__", [](const mnum &self) -> mnum
               { return -self; })
          .def("__abs__", [](const mnum &self) -> mnum
               { return self.abs(); })
-         .def("__int__", [](const mnum &self) -> int_fast64_t
-          {
-               int_fast64_t n = 0;
-               const size_t size = self.integer.size();
-               for (size_t i = 0; i < size; ++i)
-                    n  = n * 10 + self.integer[i];
-               return self.sign ? -n : n;
-          })
+         .def("__int__", [](const mnum &self) -> py::object
+              { return to_pylong(self); })
          .def("__float__", [](const mnum &self) -> double
-          {
-               const size_t int_size = self.integer.size();
-               const size_t frac_size = self.fraction.size();
-               size_t n = 0;
-               for (size_t i = 0; i < int_size; ++i)
-                    n  = n * 10 + self.integer[i];
-               size_t f = 0;
-               for (size_t i = 0; i < frac_size; ++i)
-                    f = f * 10 + self.fraction[i];
-               const double d = f / std::pow(10, frac_size);
-               return self.sign ? -(n + d) : (n + d);
-          })
+              { return self.to_double(); })
+         .def_static("from_float", [](const double value, const bool exact) -> mnum
+              { return mnum::from_double(value, exact); },
+              py::arg("value"), py::arg("exact") = false)
          .def("as_int", [](const mnum &self) -> mnum
               { return self.as_int(); })
          .def("as_float", [](const mnum &self) -> mnum
@@ -148,48 +509,48 @@ PYBIND11_MODULE(mnum, m)
          .def("float_str", [](const mnum &self) -> std::string
               { return self.float_str(); })
          .def("__add__", [](const mnum &self, const py::handle &other) -> mnum
-              { return self + cast(other); })
+              { return self + operand(other); })
          .def("__radd__", [](const mnum &self, const py::handle &other) -> mnum
               { return cast(other) + self; })
-         .def("__iadd__", [](mnum &self, const py::handle &other) -> mnum
+         .def("__iadd__", [](const py::object &self, const py::handle &other) -> py::object
           {
-               self += cast(other);
+               self.cast<mnum &>() += operand(other);
                return self;
           })
          .def("__sub__", [](const mnum &self, const py::handle &other) -> mnum
-              { return self - cast(other); })
+              { return self - operand(other); })
          .def("__rsub__", [](const mnum &self, const py::handle &other) -> mnum
               { return cast(other) - self; })
-         .def("__isub__", [](mnum &self, const py::handle &other) -> mnum
+         .def("__isub__", [](const py::object &self, const py::handle &other) -> py::object
           {
-               self -= cast(other);
+               self.cast<mnum &>() -= operand(other);
                return self;
           })
          .def("__mul__", [](const mnum &self, const py::handle &other) -> mnum
-              { return self * cast(other); })
+              { return self * operand(other); })
          .def("__rmul__", [](const mnum &self, const py::handle &other) -> mnum
               { return cast(other) * self; })
-         .def("__imul__", [](mnum &self, const py::handle &other) -> mnum
+         .def("__imul__", [](const py::object &self, const py::handle &other) -> py::object
           {
-               self *= cast(other);
+               self.cast<mnum &>() *= operand(other);
                return self;
           })
          .def("div", [](const mnum &self, const py::handle &other) -> mnum
           {
                try
                {
-                    return self.div(cast(other));
+                    return self.div(operand(other));
                } catch(const std::domain_error& e)
                {
                     PyErr_SetString(PyExc_ZeroDivisionError, e.what());
                     throw py::error_already_set();
                }
           })
-         .def("idiv", [](mnum &self, const py::handle &other) -> mnum
+         .def("idiv", [](const py::object &self, const py::handle &other) -> py::object
           {
                try
                {
-                    self.idiv(cast(other));
+                    self.cast<mnum &>().idiv(operand(other));
                     return self;
                } catch(const std::domain_error& e)
                {
@@ -201,7 +562,7 @@ PYBIND11_MODULE(mnum, m)
           {
                try
                {
-                    return self.floor_div(cast(other));
+                    return self.floor_div(operand(other));
                } catch(const std::domain_error& e)
                {
                     PyErr_SetString(PyExc_ZeroDivisionError, e.what());
@@ -219,11 +580,11 @@ PYBIND11_MODULE(mnum, m)
                     throw py::error_already_set();
                }
           })
-         .def("__ifloordiv__", [](mnum &self, const py::handle &other) -> mnum
+         .def("__ifloordiv__", [](const py::object &self, const py::handle &other) -> py::object
           {
                try
                {
-                    self.ifloor_div(cast(other));
+                    self.cast<mnum &>().ifloor_div(operand(other));
                     return self;
                } catch(const std::domain_error& e)
                {
@@ -231,18 +592,19 @@ PYBIND11_MODULE(mnum, m)
                     throw py::error_already_set();
                }
           })
-         .def("__truediv__", [](const mnum &self, const py::handle &other) -> mnum
+         .def("__truediv__", [](const mnum &self, const py::handle &other,
+                                const py::handle &precision) -> mnum
           {
                try
                {
-                    return self / cast(other);
+                    return self.true_div(operand(other), to_precision(precision));
                }
                catch (const std::domain_error &e)
                {
                     PyErr_SetString(PyExc_ZeroDivisionError, e.what());
                     throw py::error_already_set();
                }
-          })
+          }, py::arg("other"), py::kw_only(), py::arg("precision") = py::none())
          .def("__rtruediv__", [](const mnum &self, const py::handle &other) -> mnum
           {
                try
@@ -255,11 +617,11 @@ PYBIND11_MODULE(mnum, m)
                     throw py::error_already_set();
                }
           })
-         .def("__itruediv__", [](mnum &self, const py::handle &other) -> mnum
+         .def("__itruediv__", [](const py::object &self, const py::handle &other) -> py::object
           {
                try
                {
-                    self /= cast(other);
+                    self.cast<mnum &>() /= operand(other);
                     return self;
                }
                catch (const std::domain_error &e)
@@ -272,7 +634,7 @@ PYBIND11_MODULE(mnum, m)
           { 
                try
                {
-                    return self % cast(other);
+                    return self % operand(other);
                }
                catch (const std::domain_error &e)
                {
@@ -292,11 +654,11 @@ PYBIND11_MODULE(mnum, m)
                     throw py::error_already_set();
                }
           })
-         .def("__imod__", [](mnum &self, const py::handle &other) -> mnum
+         .def("__imod__", [](const py::object &self, const py::handle &other) -> py::object
           {
                try
                {
-                    self %= cast(other);
+                    self.cast<mnum &>() %= operand(other);
                     return self;
                }
                catch (const std::domain_error &e)
@@ -305,20 +667,30 @@ PYBIND11_MODULE(mnum, m)
                     throw py::error_already_set();
                }
           })
-         .def("__pow__", [](const mnum &self, const py::object &other) -> mnum
-              { return self.pow(cast(other)); })
+         .def("__pow__", [](const mnum &self, const py::object &other,
+                            const py::object &mod, const py::handle &precision) -> mnum
+          {
+               if (mod.is_none())
+                    return self.pow_prec(cast(other), to_precision(precision));
+               try
+               {
+                    return self.pow(cast(other), cast(mod));
+               }
+               catch (const std::domain_error &e)
+               {
+                    PyErr_SetString(PyExc_TypeError, e.what());
+                    throw py::error_already_set();
+               }
+          }, py::arg("other"), py::arg("mod") = py::none(),
+              py::kw_only(), py::arg("precision") = py::none())
          .def("__rpow__", [](const mnum &self, const py::object &other) -> mnum
               { return cast(other).pow(self); })
          .def("__len__", [](const mnum &self) -> size_t
               { return self.size(); })
          .def("int_len", [](const mnum &self) -> size_t
-              { return self.integer.size(); })
+              { return self.int_size(); })
          .def("frac_len", [](const mnum &self) -> size_t
-          {
-               const size_t frac_size = self.fraction.size();
-               const bool is_frac_zero = frac_size == 1 && self.fraction[0] == 0;
-               return is_frac_zero ? 0 : frac_size; // fraction length
-          })
+              { return self.frac; })
          .def("find", [](const mnum &self, const py::handle &value) -> int_fast64_t
           {
                bool sign;
@@ -352,32 +724,30 @@ PYBIND11_MODULE(mnum, m)
                return self.count(v); // value count
           })
          .def("join", [](mnum &self, const py::handle &other) -> void
-              { self.join(cast(other)); })
+              { self.join(operand(other)); })
          .def("add", [](const mnum &self, const py::handle &other) -> mnum
-              { return self.add(cast(other)); })
+              { return self.add(operand(other)); })
          .def("__getitem__", [](const mnum &self, const int_fast64_t &index) -> mnum
           {
                const size_t idx = check_index(self, index);
-               const size_t int_size = self.integer.size();
-               if (idx < int_size)
-                    return mnum({self.integer[idx]}, {0}, self.sign);
-               return mnum({self.fraction[idx - int_size]}, {0}, self.sign); // value
+               return digit_mnum(self[idx], self.sign); // value
           })
          .def("geti", [](const mnum &self, const int_fast64_t &index) -> py::object
           {
-               const size_t size = self.integer.size();
+               const size_t size = self.int_size();
                const size_t idx = (index < 0) ? index + size : index;
                if (idx >= size)
                     return py::none();
-               return py::cast(mnum({self.integer[idx]}, {0}, self.sign));
+               return py::cast(digit_mnum(self[idx], self.sign));
           })
          .def("getf", [](const mnum &self, const int_fast64_t &index) -> py::object
           {
-               const size_t size = self.fraction.size();
+               const size_t size = std::max<size_t>(self.frac, 1); // a zero fraction has one digit
                const size_t idx = (index < 0) ? index + size : index;
                if (idx >= size)
                     return py::none();
-               return py::cast(mnum({self.fraction[idx]}, {0}, self.sign));
+               const udigit value = self.frac ? self[self.int_size() + idx] : 0;
+               return py::cast(digit_mnum(value, self.sign));
           })
          .def("__setitem__", [](mnum &self, const int_fast64_t &index, const py::handle &value) -> void
           {
@@ -385,14 +755,7 @@ PYBIND11_MODULE(mnum, m)
                const size_t idx = check_index(self, index);
                const udigit d_value = to_digit(value, sign);
                self.sign = self.sign ^ sign;
-               if (idx < self.integer.size())
-               {
-                    self.integer[idx] = d_value;
-                    lstrip_zeros(self.integer); // normalize integer
-                    return;
-               }
-               self.fraction[idx - self.integer.size()] = d_value;
-               rstrip_zeros(self.fraction); // normalize fraction
+               self.assign(idx, d_value); // normalizes both parts
           })
          .def("insert", [](mnum &self, const int_fast64_t &index, const py::handle &value) -> void
           {
@@ -405,13 +768,7 @@ PYBIND11_MODULE(mnum, m)
                else if (index < 0)
                     self.insert(0, v);
                else
-               { // insert at the end
-                    if (self.fraction.size() == 1 &&
-                         self.fraction[0] == 0)
-                         self.integer.push_back(v);
-                    else
-                         self.fraction.push_back(v);
-               }
+                    self.append(v); // insert at the end
                self.sign = self.sign ^ sign; // toggle sign
           })
          .def("__delitem__", [](mnum &self, const int_fast64_t &index) -> void
@@ -437,5 +794,99 @@ PYBIND11_MODULE(mnum, m)
          .def("sort", [](mnum &self) -> void
               { self.sort(); })
          .def("reverse", [](mnum &self) -> void
-              { self.reverse(); });
+              { self.reverse(); })
+         .def("isqrt", [](const mnum &self) -> mnum
+              { return self.isqrt(); })
+         .def("sqrt", [](const mnum &self, const py::handle &precision) -> mnum
+              { return self.sqrt(to_precision(precision)); },
+              py::kw_only(), py::arg("precision") = py::none())
+         .def("nth_root", [](const mnum &self, const size_t n,
+                             const py::handle &precision) -> mnum
+              { return self.nth_root(n, to_precision(precision)); },
+              py::arg("n"), py::kw_only(), py::arg("precision") = py::none())
+         .def("quantize", [](const mnum &self, const size_t digits,
+                             const py::object &mode) -> mnum
+              { return self.quantize(digits, mode.is_none() ?
+                                     getcontext().mode : mode.cast<rounding>()); },
+              py::arg("digits"), py::arg("rounding") = py::none());
+
+     py::enum_<rounding>(m, "rounding")
+         .value("ROUND_HALF_EVEN", ROUND_HALF_EVEN)
+         .value("ROUND_DOWN", ROUND_DOWN)
+         .value("ROUND_UP", ROUND_UP)
+         .value("ROUND_CEILING", ROUND_CEILING)
+         .value("ROUND_FLOOR", ROUND_FLOOR)
+         .export_values();
+
+     py::class_<context>(m, "context")
+         .def_property("precision", [](const context &self) -> size_t
+              { return self.precision; },
+              [](context &self, const py::handle &value) -> void
+          {
+               if (value.is_none())
+                    throw py::type_error("precision must be an int");
+               const long long n = value.cast<long long>();
+               if (n < 0)
+                    throw py::value_error("precision must be non-negative");
+               self.precision = static_cast<size_t>(n);
+          })
+         .def_property("max_fraction", [](const context &self) -> py::object
+          {
+               if (self.max_fraction == UNBOUNDED)
+                    return py::none();
+               return py::int_(self.max_fraction);
+          },
+              [](context &self, const py::handle &value) -> void
+          {
+               if (value.is_none())
+               { // keep every fraction digit
+                    self.max_fraction = UNBOUNDED;
+                    return;
+               }
+               const long long n = value.cast<long long>();
+               if (n < 0)
+                    throw py::value_error("max_fraction must be non-negative");
+               self.max_fraction = static_cast<size_t>(n);
+          })
+         .def_readwrite("rounding", &context::mode)
+         .def("__repr__", [](const context &self) -> std::string
+          {
+               const std::string max_fraction = self.max_fraction == UNBOUNDED ?
+                    "None" : std::to_string(self.max_fraction);
+               return "context(precision=" + std::to_string(self.precision) +
+                      ", max_fraction=" + max_fraction +
+                      ", rounding=" + py::str(py::cast(self.mode)).cast<std::string>() + ")";
+          });
+
+     py::class_<divisor>(m.attr("mnum"), "Divisor")
+         .def(py::init([](const py::handle &handle)
+          {
+               try
+               {
+                    return divisor(operand(handle));
+               }
+               catch (const std::domain_error &e)
+               {
+                    PyErr_SetString(PyExc_ZeroDivisionError, e.what());
+                    throw py::error_already_set();
+               }
+          }))
+         .def_property_readonly("value", [](const divisor &self) -> mnum
+              { return self.value(); })
+         .def("div", [](const divisor &self, const py::handle &other) -> mnum
+              { return self.div(operand(other)); })
+         .def("mod", [](const divisor &self, const py::handle &other) -> mnum
+              { return self.mod(operand(other)); })
+         .def("divmod", [](const divisor &self, const py::handle &other) -> py::tuple
+          {
+               std::pair<mnum, mnum> div = self.divmod(operand(other));
+               return py::make_tuple(std::move(div.first), std::move(div.second));
+          })
+         .def("__repr__", [](const divisor &self) -> std::string
+              { return "Divisor(" + self.value().str() + ")"; });
+
+     m.def("getcontext", &getcontext, py::return_value_policy::reference,
+           "Get the arithmetic context of the current thread.");
+
+     install_number_slots(m.attr("mnum"));
 }
\ No newline at end of file
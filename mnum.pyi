@@ -5,7 +5,15 @@ import typing
 import mnum
 
 __all__ = [
-    "mnum"
+    "ROUND_CEILING",
+    "ROUND_DOWN",
+    "ROUND_FLOOR",
+    "ROUND_HALF_EVEN",
+    "ROUND_UP",
+    "context",
+    "getcontext",
+    "mnum",
+    "rounding"
 ]
 
 
@@ -77,6 +85,8 @@ class mnum():
     def __contains__(self, value: mnum) -> bool: ...
     def __int__(self) -> int: ...
     def __float__(self) -> float: ...
+    @staticmethod
+    def from_float(value: float, exact: bool = False) -> mnum: ...
     def __pos__(self) -> mnum: ...
     def __neg__(self) -> mnum: ...
     def __abs__(self) -> mnum: ...
@@ -161,13 +171,13 @@ class mnum():
     @typing.overload
     def __rfloordiv__(self, value: mnum) -> mnum: ...
     @typing.overload
-    def __truediv__(self, value: int) -> mnum: ...
+    def __truediv__(self, value: int, *, precision: int | None = None) -> mnum: ...
     @typing.overload
-    def __truediv__(self, value: float) -> mnum: ...
+    def __truediv__(self, value: float, *, precision: int | None = None) -> mnum: ...
     @typing.overload
-    def __truediv__(self, value: str) -> mnum: ...
+    def __truediv__(self, value: str, *, precision: int | None = None) -> mnum: ...
     @typing.overload
-    def __truediv__(self, value: mnum) -> mnum: ...
+    def __truediv__(self, value: mnum, *, precision: int | None = None) -> mnum: ...
     @typing.overload
     def __rtruediv__(self, value: int) -> mnum: ...
     @typing.overload
@@ -193,13 +203,13 @@ class mnum():
     @typing.overload
     def __rmod__(self, value: mnum) -> mnum: ...
     @typing.overload
-    def __pow__(self, value: int) -> mnum: ...
+    def __pow__(self, value: int, mod: int | str | mnum | None = None, *, precision: int | None = None) -> mnum: ...
     @typing.overload
-    def __pow__(self, value: float) -> mnum: ...
+    def __pow__(self, value: float, mod: int | str | mnum | None = None, *, precision: int | None = None) -> mnum: ...
     @typing.overload
-    def __pow__(self, value: str) -> mnum: ...
+    def __pow__(self, value: str, mod: int | str | mnum | None = None, *, precision: int | None = None) -> mnum: ...
     @typing.overload
-    def __pow__(self, value: mnum) -> mnum: ...
+    def __pow__(self, value: mnum, mod: int | str | mnum | None = None, *, precision: int | None = None) -> mnum: ...
     @typing.overload
     def __rpow__(self, value: int) -> mnum: ...
     @typing.overload
@@ -267,5 +277,80 @@ class mnum():
     def clear(self) -> None: ...
     def sort(self) -> None: ...
     def reverse(self) -> None: ...
+    def isqrt(self) -> mnum: ...
+    def sqrt(self, *, precision: int | None = None) -> mnum: ...
+    def nth_root(self, n: int, *, precision: int | None = None) -> mnum: ...
+    def quantize(self, digits: int, rounding: rounding | None = None) -> mnum: ...
+    class Divisor():
+        @typing.overload
+        def __init__(self, value: int) -> None: ...
+        @typing.overload
+        def __init__(self, value: float) -> None: ...
+        @typing.overload
+        def __init__(self, value: str) -> None: ...
+        @typing.overload
+        def __init__(self, value: mnum) -> None: ...
+        @property
+        def value(self) -> mnum: ...
+        @typing.overload
+        def div(self, value: int) -> mnum: ...
+        @typing.overload
+        def div(self, value: float) -> mnum: ...
+        @typing.overload
+        def div(self, value: str) -> mnum: ...
+        @typing.overload
+        def div(self, value: mnum) -> mnum: ...
+        @typing.overload
+        def mod(self, value: int) -> mnum: ...
+        @typing.overload
+        def mod(self, value: float) -> mnum: ...
+        @typing.overload
+        def mod(self, value: str) -> mnum: ...
+        @typing.overload
+        def mod(self, value: mnum) -> mnum: ...
+        @typing.overload
+        def divmod(self, value: int) -> tuple[mnum, mnum]: ...
+        @typing.overload
+        def divmod(self, value: float) -> tuple[mnum, mnum]: ...
+        @typing.overload
+        def divmod(self, value: str) -> tuple[mnum, mnum]: ...
+        @typing.overload
+        def divmod(self, value: mnum) -> tuple[mnum, mnum]: ...
+        def __repr__(self) -> str: ...
+        pass
+
     __hash__ = None
     pass
+
+
+class rounding():
+    ROUND_HALF_EVEN: typing.ClassVar[rounding]
+    ROUND_DOWN: typing.ClassVar[rounding]
+    ROUND_UP: typing.ClassVar[rounding]
+    ROUND_CEILING: typing.ClassVar[rounding]
+    ROUND_FLOOR: typing.ClassVar[rounding]
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    @property
+    def name(self) -> str: ...
+    @property
+    def value(self) -> int: ...
+    pass
+
+
+ROUND_HALF_EVEN: rounding
+ROUND_DOWN: rounding
+ROUND_UP: rounding
+ROUND_CEILING: rounding
+ROUND_FLOOR: rounding
+
+
+class context():
+    precision: int
+    max_fraction: int | None
+    rounding: rounding
+    def __repr__(self) -> str: ...
+    pass
+
+
+def getcontext() -> context: ...
@@ -0,0 +1,120 @@
+#ifndef TEST_H
+#define TEST_H
+#include <cstdio>
+#include <random>
+#include <string>
+#include "mnum.h"
+
+/*
+ * Minimal checks shared by the C++ tests. A failed check prints its
+ * location and the test keeps going, test_result() gives the exit code.
+ */
+
+static int test_failures = 0;
+
+#define CHECK(cond)                                                     \
+    do                                                                  \
+    {                                                                   \
+        if (!(cond))                                                    \
+        {                                                               \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, \
+                         __LINE__, #cond);                              \
+            ++test_failures;                                            \
+        }                                                               \
+    } while (0)
+
+#define CHECK_STR(value, expected) CHECK((value).str() == std::string(expected))
+
+#define CHECK_THROWS(expr, error)   \
+    do                              \
+    {                               \
+        bool thrown = false;        \
+        try                         \
+        {                           \
+            expr;                   \
+        }                           \
+        catch (const error &)       \
+        {                           \
+            thrown = true;          \
+        }                           \
+        CHECK(thrown && #expr);     \
+    } while (0)
+
+inline int test_result(const char *name)
+{
+    std::printf("%s: %s\n", name, test_failures ? "FAILED" : "ok");
+    return test_failures ? 1 : 0;
+}
+
+// restores the thread context when a test returns.
+struct context_scope
+{
+    const context saved = getcontext();
+    ~context_scope() { getcontext() = this->saved; }
+};
+
+// generator shared by a test, seeded for reproducible failures.
+inline std::mt19937_64 &test_rng()
+{
+    static std::mt19937_64 rng(20240601);
+    return rng;
+}
+
+// random value of exactly size limbs (top limb non zero).
+inline limb_vector random_limbs(const size_t size)
+{
+    limb_vector x(size);
+    for (limb &l : x)
+        l = static_cast<limb>(test_rng()() % LIMB_BASE);
+    if (size && x.back() == 0)
+        x.back() = 1;
+    return x;
+}
+
+// random digits of exactly size digits (leading digit non zero).
+inline std::string random_number(const size_t size)
+{
+    std::string s;
+    for (size_t i = 0; i < size; ++i)
+        s += static_cast<char>('0' + test_rng()() % 10);
+    if (size && s[0] == '0')
+        s[0] = '1';
+    return s;
+}
+
+// schoolbook product carried digit by digit, the reference for the
+// multiplication tiers.
+inline limb_vector ref_mul(const limb_vector &x, const limb_vector &y)
+{
+    limb_vector res(x.size() + y.size(), 0);
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        dlimb carry = 0;
+        for (size_t j = 0; j < y.size(); ++j)
+        {
+            const dlimb cur = static_cast<dlimb>(x[i]) * y[j] + res[i + j] + carry;
+            res[i + j] = static_cast<limb>(cur % LIMB_BASE);
+            carry = cur / LIMB_BASE;
+        }
+        for (size_t k = i + y.size(); carry; ++k)
+        {
+            const dlimb cur = res[k] + carry;
+            res[k] = static_cast<limb>(cur % LIMB_BASE);
+            carry = cur / LIMB_BASE;
+        }
+    }
+    trim_limbs(res);
+    return res;
+}
+
+// quotient and remainder are consistent: q * y + r == x and r < y.
+inline bool check_divmod(const limb_vector &x, const limb_vector &y,
+                         const std::pair<limb_vector, limb_vector> &div)
+{
+    limb_vector back = ref_mul(div.first, y);
+    liadd(back, div.second);
+    trim_limbs(back);
+    return lcmp(back, x) == 0 && lcmp(div.second, y) < 0;
+}
+
+#endif // TEST_H
@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+#include "test.h"
+
+// a block is reused by the next request of its size class.
+bool reused(const size_t freed, const size_t requested)
+{
+    block_pool &pool = get_pool();
+    void *block = pool.allocate(freed);
+    pool.deallocate(block, freed);
+    void *again = pool.allocate(requested);
+    const bool same = again == block;
+    pool.deallocate(again, requested);
+    return same;
+}
+
+void test_pool()
+{
+    // requests just below, at and just above the smallest block
+    CHECK(reused(POOL_MIN_BLOCK - 1, POOL_MIN_BLOCK));
+    CHECK(reused(POOL_MIN_BLOCK, 1));
+    CHECK(reused(POOL_MIN_BLOCK + 1, 2 * POOL_MIN_BLOCK));
+    CHECK(!reused(POOL_MIN_BLOCK + 1, POOL_MIN_BLOCK));
+    // the largest class is still pooled
+    const size_t largest = POOL_MIN_BLOCK << (POOL_CLASSES - 1);
+    CHECK(reused(largest - 1, largest));
+    CHECK(reused(largest / 2 + 1, largest));
+
+    // only POOL_MAX_CACHED blocks of a class are kept
+    block_pool &pool = get_pool();
+    std::vector<void *> blocks;
+    for (size_t i = 0; i <= POOL_MAX_CACHED; ++i)
+        blocks.push_back(pool.allocate(POOL_MIN_BLOCK));
+    for (void *block : blocks)
+        pool.deallocate(block, POOL_MIN_BLOCK);
+    const std::set<void *> cached(blocks.begin(), blocks.begin() + POOL_MAX_CACHED);
+    std::vector<void *> again;
+    for (size_t i = 0; i < POOL_MAX_CACHED; ++i)
+        again.push_back(pool.allocate(POOL_MIN_BLOCK));
+    CHECK(std::set<void *>(again.begin(), again.end()) == cached);
+    for (void *block : again)
+        pool.deallocate(block, POOL_MIN_BLOCK);
+
+    // blocks are writable over their requested size
+    for (size_t bytes = 1; bytes <= 2 * largest; bytes = 2 * bytes + 1)
+    {
+        char *block = static_cast<char *>(pool.allocate(bytes));
+        std::memset(block, 0xab, bytes);
+        pool.deallocate(block, bytes);
+    }
+}
+
+void test_pool_allocator()
+{
+    // digit and limb vectors growing through the size classes
+    for (size_t size = INLINE_DIGITS; size <= 4 * POOL_MIN_BLOCK; ++size)
+    {
+        digit_vector x(size, 7);
+        limb_vector y(size, LIMB_BASE - 1);
+        x.push_back(3);
+        y.push_back(1);
+        CHECK(x.size() == size + 1 && x[size - 1] == 7 && x[size] == 3);
+        CHECK(y.size() == size + 1 && y[size - 1] == LIMB_BASE - 1 && y[size] == 1);
+    }
+    // products whose buffers straddle the block sizes
+    for (size_t size = POOL_MIN_BLOCK / sizeof(limb) - 1;
+         size <= POOL_MIN_BLOCK / sizeof(limb) + 1; ++size)
+    {
+        const limb_vector x = random_limbs(size), y = random_limbs(size + 1);
+        CHECK(lmul(x, y) == ref_mul(x, y));
+    }
+}
+
+void test_arena()
+{
+    scratch_arena &arena = get_arena();
+    const scratch_arena::mark start = arena.top();
+    limb *first;
+    {
+        scratch_scope scope;
+        first = scope.alloc<limb>(3);
+        CHECK(reinterpret_cast<uintptr_t>(first) % ARENA_ALIGN == 0);
+        {
+            scratch_scope inner;
+            limb *second = inner.alloc<limb>(1);
+            CHECK(reinterpret_cast<uintptr_t>(second) % ARENA_ALIGN == 0);
+            CHECK(second >= first + 3);
+        }
+        // the inner scope gave its memory back
+        limb *third = scope.alloc<limb>(1);
+        CHECK(third >= first + 3);
+        CHECK(third == reinterpret_cast<limb *>(reinterpret_cast<char *>(first) + ARENA_ALIGN));
+    }
+    {
+        scratch_scope scope;
+        CHECK(scope.alloc<limb>(1) == first);
+    }
+    // allocations just below, at and just above a whole chunk
+    for (size_t bytes = ARENA_CHUNK - 1; bytes <= ARENA_CHUNK + 1; ++bytes)
+    {
+        scratch_scope scope;
+        char *a = scope.alloc<char>(bytes);
+        char *b = scope.alloc<char>(bytes);
+        std::memset(a, 1, bytes);
+        std::memset(b, 2, bytes);
+        CHECK(a[bytes - 1] == 1 && b[0] == 2);
+        CHECK(b >= a + bytes || a >= b + bytes);
+    }
+    CHECK(arena.top().chunk == start.chunk && arena.top().offset == start.offset);
+}
+
+int main()
+{
+    test_pool();
+    test_pool_allocator();
+    test_arena();
+    return test_result("alloc");
+}
@@ -0,0 +1,104 @@
+#include "test.h"
+
+void test_precision()
+{
+    context_scope scope;
+    CHECK(getcontext().precision == 20);
+    CHECK_STR(mnum(1) / mnum(3), "0.33333333333333333334");
+    getcontext().precision = 5;
+    CHECK_STR(mnum(1) / mnum(3), "0.33334");
+    CHECK_STR(mnum(3).pow(mnum(-1)), "0.33334");
+    CHECK_STR(mnum(2) / mnum(3), "0.66667");
+    CHECK_STR(mnum(1) / mnum(8), "0.125");
+    // a single division overrides the context
+    CHECK(mnum(1).true_div(mnum(7), 50).frac == 50);
+    getcontext().precision = 0;
+    CHECK_STR(mnum(2) / mnum(3), "1");
+    // the fraction limit also caps division
+    getcontext().precision = 20;
+    getcontext().max_fraction = 3;
+    CHECK_STR(mnum(1) / mnum(3), "0.334");
+}
+
+void test_rounding_modes()
+{
+    const char *values[] = {"2.5", "3.5", "-2.5", "2.51", "-2.49", "2.1", "-2.1"};
+    const char *expected[][7] = {
+        {"2", "4", "-2", "3", "-2", "2", "-2"},  // ROUND_HALF_EVEN
+        {"2", "3", "-2", "2", "-2", "2", "-2"},  // ROUND_DOWN
+        {"3", "4", "-3", "3", "-3", "3", "-3"},  // ROUND_UP
+        {"3", "4", "-2", "3", "-2", "3", "-2"},  // ROUND_CEILING
+        {"2", "3", "-3", "2", "-3", "2", "-3"}}; // ROUND_FLOOR
+    for (int mode = ROUND_HALF_EVEN; mode <= ROUND_FLOOR; ++mode)
+        for (size_t i = 0; i < 7; ++i)
+            CHECK_STR(mnum(values[i]).quantize(0, static_cast<rounding>(mode)), expected[mode][i]);
+    CHECK_STR(mnum("2.0").quantize(0, ROUND_UP), "2");
+}
+
+void test_max_fraction()
+{
+    context_scope scope;
+    getcontext().max_fraction = 2;
+    getcontext().mode = ROUND_HALF_EVEN;
+    CHECK_STR(mnum("1.005") + mnum("0.0001"), "1.01");
+    CHECK_STR(mnum("1.25") * mnum("0.1"), "0.12");
+    CHECK_STR(mnum("1.35") * mnum("0.1"), "0.14");
+    CHECK_STR(mnum("1.5").pow(mnum(3)), "3.38");
+}
+
+// value computed with every digit, then rounded once.
+mnum exact_then_round(const mnum &x, const mnum &y, const bool power)
+{
+    const context saved = getcontext();
+    getcontext().max_fraction = UNBOUNDED;
+    const mnum exact = power ? x.pow(y) : x * y;
+    getcontext() = saved;
+    return exact.quantize(saved.max_fraction, saved.mode);
+}
+
+// long operands are truncated to the digits that reach the guard limb
+void test_bounded_chains()
+{
+    context_scope scope;
+    for (int mode = ROUND_HALF_EVEN; mode <= ROUND_FLOOR; ++mode)
+    {
+        getcontext().mode = static_cast<rounding>(mode);
+        for (int i = 0; i < 50; ++i)
+        {
+            getcontext().max_fraction = test_rng()() % 30;
+            const mnum x((i % 3 ? "-" : "") + random_number(1 + i % 4) + "." + random_number(40 + i));
+            const mnum y(random_number(1 + i % 2) + "." + random_number(60 - i));
+            CHECK((x * y).str() == exact_then_round(x, y, false).str());
+            const mnum e(static_cast<int_fast64_t>(2 + i % 40));
+            CHECK(x.pow(e).str() == exact_then_round(x, e, true).str());
+        }
+    }
+}
+
+// guard digits on a boundary fall back to the exact product
+void test_guard_boundaries()
+{
+    context_scope scope;
+    getcontext().max_fraction = 0;
+    getcontext().mode = ROUND_HALF_EVEN;
+    CHECK_STR(mnum("0.5000000000000000000000000000000000000000000001") * mnum(1), "1");
+    // truncated operands land just below half and just below a unit
+    const std::string nines(59, '9'), zeros(39, '0');
+    CHECK_STR(mnum("0.4" + nines) * mnum("1." + zeros + "1"), "1");
+    getcontext().mode = ROUND_DOWN;
+    CHECK_STR(mnum("1.4" + nines) * mnum("2." + zeros + "1"), "3");
+    // many squarings with a small result
+    getcontext().max_fraction = 30;
+    getcontext().mode = ROUND_HALF_EVEN;
+    CHECK_STR(mnum("1.0000003").pow(mnum(100000)), "1.030454529316472390663833962037");
+}
+
+int main()
+{
+    test_precision();
+    test_rounding_modes();
+    test_max_fraction();
+    test_bounded_chains();
+    test_guard_boundaries();
+    return test_result("context");
+}
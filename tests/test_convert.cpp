@@ -0,0 +1,118 @@
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "test.h"
+
+// horner's rule over 32 bit words, the reference for from_binary.
+limb_vector ref_from_binary(const std::vector<uint32_t> &words)
+{
+    limb_vector x;
+    for (size_t i = words.size(); i-- > 0;)
+    {
+        lmul_small(x, 1U << 16);
+        lmul_small(x, 1U << 16);
+        liadd(x, limb_vector({words[i] % LIMB_BASE, words[i] / LIMB_BASE}));
+        trim_limbs(x);
+    }
+    return x;
+}
+
+// binary words convert by divide and conquer above the 8 word base case.
+void test_from_binary()
+{
+    for (size_t size = 1; size <= 40; ++size)
+    {
+        std::vector<uint32_t> words(size);
+        for (uint32_t &w : words)
+            w = static_cast<uint32_t>(test_rng()());
+        CHECK(from_binary(words) == ref_from_binary(words));
+        std::fill(words.begin(), words.end(), UINT32_MAX);
+        CHECK(from_binary(words) == ref_from_binary(words));
+    }
+    std::vector<uint32_t> power(17, 0);
+    power.back() = 1; // 2^512
+    CHECK(convert(from_limbs(from_binary(power))) ==
+          "13407807929942597099574024998205846127479365820592393377723561443721764030073546"
+          "976801874298166903427690031858186486050853753882811946569946433649006084096");
+}
+
+// random finite doubles from their bit patterns.
+double random_double()
+{
+    while (true)
+    {
+        const uint64_t bits = test_rng()();
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        if (std::isfinite(d))
+            return d;
+    }
+}
+
+// fewest significant digits that read back as d.
+size_t shortest_length(const double d)
+{
+    char buf[40];
+    for (int digits = 1;; ++digits)
+    {
+        std::snprintf(buf, sizeof(buf), "%.*e", digits - 1, d);
+        if (std::strtod(buf, nullptr) == d)
+            return digits;
+    }
+}
+
+// significant digits of a decimal string.
+size_t significant_length(const std::string &s)
+{
+    std::string digits;
+    for (const char c : s)
+        if (c >= '0' && c <= '9')
+            digits += c;
+    const size_t first = digits.find_first_not_of('0');
+    if (first == std::string::npos)
+        return 1;
+    return digits.find_last_not_of('0') - first + 1;
+}
+
+void test_double_conversion()
+{
+    CHECK_STR(mnum::from_double(0.1), "0.1");
+    CHECK_STR(mnum::from_double(123.456), "123.456");
+    CHECK_STR(mnum::from_double(1e-7), "0.0000001");
+    CHECK_STR(mnum::from_double(1e22), "10000000000000000000000");
+    CHECK_STR(mnum::from_double(9007199254740993.0), "9007199254740992");
+    CHECK_STR(mnum::from_double(0.1, true), "0.1000000000000000055511151231257827021181583404541015625");
+    CHECK(mnum::from_double(5e-324).frac == 324);
+    CHECK(mnum::from_double(DBL_MAX).int_size() == 309);
+    CHECK_THROWS(mnum::from_double(NAN), std::invalid_argument);
+    CHECK_THROWS(mnum::from_double(-INFINITY), std::overflow_error);
+
+    // ties round to even, digits past the first 768 still break ties
+    CHECK(mnum("9007199254740993").to_double() == 9007199254740992.0);
+    CHECK(mnum("9007199254740995").to_double() == 9007199254740996.0);
+    CHECK(mnum("9007199254740993." + std::string(800, '0') + "1").to_double() == 9007199254740994.0);
+    // half of the smallest subnormal, just above and just below
+    const std::string tiny = "0." + std::string(323, '0') +
+                             "2470328229206232720882843964341106861825299013071623822127928412503377536";
+    CHECK(mnum(tiny + "4").to_double() == 5e-324);
+    CHECK(mnum(tiny + "3").to_double() == 0.0);
+    CHECK(mnum("1" + std::string(400, '0')).to_double() == INFINITY);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const double d = random_double();
+        const mnum shortest = mnum::from_double(d), exact = mnum::from_double(d, true);
+        CHECK(shortest.to_double() == d);
+        CHECK(exact.to_double() == d);
+        CHECK(std::strtod(shortest.str().c_str(), nullptr) == d);
+        CHECK(significant_length(shortest.str()) == shortest_length(d));
+    }
+}
+
+int main()
+{
+    test_from_binary();
+    test_double_conversion();
+    return test_result("convert");
+}
@@ -0,0 +1,62 @@
+#include <vector>
+#include "test.h"
+
+typedef udigit (*add_kernel)(udigit *, const udigit *, size_t, udigit);
+typedef udigit (*sub_kernel)(udigit *, const udigit *, size_t, udigit, bool);
+
+// random digits, or runs of 9s and 0s that carry and borrow through lanes.
+std::vector<udigit> kernel_digits(const size_t size, const int kind)
+{
+    std::vector<udigit> x(size);
+    for (udigit &d : x)
+        d = kind == 0 ? test_rng()() % 10 : kind == 1 ? 9 : 0;
+    return x;
+}
+
+// a kernel agrees with the portable loop on sizes around the 16 and 32 lanes.
+void check_kernels(const add_kernel add, const sub_kernel sub)
+{
+    for (size_t size = 0; size <= 70; ++size)
+        for (int kind = 0; kind < 3; ++kind)
+            for (udigit carry = 0; carry <= 1; ++carry)
+            {
+                const std::vector<udigit> x = kernel_digits(size, kind);
+                const std::vector<udigit> y = kernel_digits(size, kind == 2 ? 1 : kind);
+                std::vector<udigit> a = x, b = x;
+                CHECK(add(a.data(), y.data(), size, carry) ==
+                      add_digits_scalar(b.data(), y.data(), size, carry));
+                CHECK(a == b);
+                for (const bool reverse : {false, true})
+                {
+                    a = x, b = x;
+                    CHECK(sub(a.data(), y.data(), size, carry, reverse) ==
+                          sub_digits_scalar(b.data(), y.data(), size, carry, reverse));
+                    CHECK(a == b);
+                }
+            }
+}
+
+void test_simd_kernels()
+{
+    check_kernels(add_digits, sub_digits);
+#ifdef SIMD_X86
+    bool sse41, avx2;
+    detect_cpu(sse41, avx2);
+    if (sse41)
+        check_kernels(add_digits_sse, sub_digits_sse);
+    if (avx2)
+        check_kernels(add_digits_avx2, sub_digits_avx2);
+#endif
+    // carries through whole blocks into the integer part
+    const std::string nines = std::string(34, '9') + "." + std::string(35, '9');
+    const std::string unit = "0." + std::string(34, '0') + "1";
+    const std::string power = "1" + std::string(34, '0');
+    CHECK(mnum(nines) + mnum(unit) == mnum(power));
+    CHECK(mnum(power) - mnum(unit) == mnum(nines));
+}
+
+int main()
+{
+    test_simd_kernels();
+    return test_result("digits");
+}
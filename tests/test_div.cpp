@@ -0,0 +1,65 @@
+#include "test.h"
+
+// long division of x_size by y_size limbs is consistent.
+void check_division(const size_t x_size, const size_t y_size)
+{
+    const limb_vector x = random_limbs(x_size), y = random_limbs(y_size);
+    CHECK(check_divmod(x, y, ldivmod(x, y)));
+}
+
+void test_long_division()
+{
+    for (size_t y_size = 2; y_size < 12; ++y_size)
+        for (size_t x_size = y_size - 1; x_size < 3 * y_size; x_size += 3)
+            check_division(x_size, y_size);
+    // small top limb needs the most normalization
+    limb_vector y = random_limbs(5);
+    y.back() = 1;
+    const limb_vector x = random_limbs(13);
+    CHECK(check_divmod(x, y, ldivmod(x, y)));
+    // maximal top limbs make the quotient estimate overshoot
+    const limb_vector top(6, LIMB_BASE - 1);
+    limb_vector z = ref_mul(top, random_limbs(4));
+    CHECK(check_divmod(z, top, ldivmod(z, top)));
+    liadd(z, limb_vector(1, 1));
+    CHECK(check_divmod(z, top, ldivmod(z, top)));
+    CHECK(check_divmod(top, top, ldivmod(top, top)));
+    CHECK_THROWS(ldivmod(top, limb_vector()), std::domain_error);
+}
+
+void test_burnikel_ziegler()
+{
+    for (size_t y_size = BZ_THRESHOLD - 1; y_size <= BZ_THRESHOLD + 1; ++y_size)
+        for (const size_t extra : {BZ_THRESHOLD - 1, BZ_THRESHOLD, BZ_THRESHOLD + 1, 3 * y_size})
+        {
+            const limb_vector x = random_limbs(y_size + extra), y = random_limbs(y_size);
+            const std::pair<limb_vector, limb_vector> div = ldivmod(x, y);
+            CHECK(check_divmod(x, y, div));
+            CHECK(div == div_basecase(x, y));
+        }
+    // several recursion levels and an odd block count
+    const limb_vector x = random_limbs(1001), y = random_limbs(7 * BZ_THRESHOLD + 3);
+    CHECK(check_divmod(x, y, ldivmod(x, y)));
+    const limb_vector top(4 * BZ_THRESHOLD, LIMB_BASE - 1);
+    const limb_vector z = ref_mul(top, random_limbs(3 * BZ_THRESHOLD));
+    CHECK(ldivmod(z, top).second.empty());
+}
+
+void test_signed_division()
+{
+    const mnum x("123456789012345678901234567890"), y("9876543210987");
+    CHECK_STR(x.div(y), "12499999886094578");
+    CHECK_STR(x % y, "1249943839404");
+    CHECK_STR((-x).floor_div(y), "-12499999886094579");
+    CHECK_STR((-x) % y, "8626599371583");
+    CHECK_STR(x % (-y), "-8626599371583");
+    CHECK_THROWS(x % mnum(0), std::domain_error);
+}
+
+int main()
+{
+    test_long_division();
+    test_burnikel_ziegler();
+    test_signed_division();
+    return test_result("div");
+}
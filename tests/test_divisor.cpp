@@ -0,0 +1,88 @@
+#include <vector>
+#include "test.h"
+#include "divisor.h"
+
+// signed number of int_size integer and frac_size fraction digits.
+mnum signed_number(const size_t int_size, const size_t frac_size, const bool sign)
+{
+    std::string s = sign ? "-" : "";
+    s += random_number(int_size);
+    if (frac_size)
+        s += "." + random_number(frac_size);
+    return mnum(s);
+}
+
+// divisor results match the mnum operations.
+void check_divisor(const mnum &x, const divisor &d)
+{
+    const mnum &y = d.value();
+    CHECK(d.div(x) == x.div(y));
+    CHECK(d.mod(x) == x % y);
+    const std::pair<mnum, mnum> div = d.divmod(x);
+    CHECK(div.first == x.floor_div(y));
+    CHECK(div.second == x % y);
+}
+
+void test_barrett_steps()
+{
+    // divisors just below, at and just above the stepping threshold
+    for (size_t k = BARRETT_THRESHOLD - 1; k <= BARRETT_THRESHOLD + 1; ++k)
+    {
+        const limb_vector m = random_limbs(k), mu = barrett_reciprocal(m);
+        for (const size_t size : {k, 2 * k, 2 * k + 1, 3 * k - 1, 5 * k + 3})
+        {
+            const limb_vector x = random_limbs(size);
+            CHECK(check_divmod(x, m, barrett_ldivmod(x, m, mu)));
+        }
+        // multiples of m leave no remainder
+        const limb_vector x = ref_mul(m, random_limbs(3 * k));
+        const std::pair<limb_vector, limb_vector> div = barrett_ldivmod(x, m, mu);
+        CHECK(check_divmod(x, m, div));
+        CHECK(div.second.empty());
+    }
+}
+
+void test_divisor()
+{
+    for (size_t k = BARRETT_THRESHOLD - 1; k <= BARRETT_THRESHOLD + 1; ++k)
+        for (const size_t frac : {0U, 3U})
+            for (const bool ysign : {false, true})
+            {
+                const divisor d(signed_number(k * LIMB_DIGITS - frac, frac, ysign));
+                for (const size_t size : {k, 2 * k, 2 * k + 1, 5 * k + 3})
+                    for (const bool xsign : {false, true})
+                    {
+                        // dividends scaled to the divisor fraction and finer ones
+                        check_divisor(signed_number(size * LIMB_DIGITS, frac, xsign), d);
+                        check_divisor(signed_number(size * LIMB_DIGITS, 0, xsign), d);
+                        check_divisor(signed_number(size * LIMB_DIGITS, frac + 2, xsign), d);
+                    }
+                // exact multiples and values below the divisor
+                check_divisor(d.value() * mnum(-12345), d);
+                check_divisor(mnum(1), d);
+                check_divisor(-mnum(1), d);
+                check_divisor(mnum(0), d);
+            }
+}
+
+void test_small_divisor()
+{
+    const divisor seven(mnum(7)), half(mnum("-0.5"));
+    CHECK_STR(seven.div(mnum(-20)), "-2");
+    CHECK_STR(seven.mod(mnum(-20)), "1");
+    CHECK_STR(seven.divmod(mnum(-20)).first, "-3");
+    CHECK_STR(half.mod(mnum("1.75")), "-0.25");
+    CHECK_STR(half.divmod(mnum("1.75")).first, "-4");
+    CHECK_STR(seven.value(), "7");
+    CHECK_THROWS(divisor(mnum(0)), std::domain_error);
+    CHECK_THROWS(divisor(mnum("0.000")), std::domain_error);
+    CHECK_THROWS(divisor(mnum("-0")), std::domain_error);
+}
+
+int main()
+{
+    test_barrett_steps();
+    test_divisor();
+    test_small_divisor();
+    return test_result("divisor");
+}
@@ -0,0 +1,35 @@
+import pytest
+
+from mnum import mnum
+
+
+# divisors of 7, 8 and 9 limbs straddle the barrett stepping threshold
+@pytest.mark.parametrize("digits", [63, 72, 81])
+@pytest.mark.parametrize("frac", ["", ".125"])
+@pytest.mark.parametrize("sign", [1, -1])
+def test_matches_operators(digits, frac, sign):
+    y = mnum(str(sign * int("7" * digits)) + frac)
+    d = mnum.Divisor(y)
+    assert d.value == y
+    for size in (digits, 2 * digits, 2 * digits + 9, 5 * digits):
+        for x in (mnum("3" * size), mnum("-" + "8" * size + ".5"), mnum("1" * size + ".00001")):
+            assert d.div(x) == x.div(y)
+            assert d.mod(x) == x % y
+            assert d.divmod(x) == (x // y, x % y)
+
+
+def test_operand_types():
+    d = mnum.Divisor(7)
+    assert d.div(-20) == -2
+    assert d.mod(-20) == 1
+    assert d.divmod(-20) == (mnum(-3), mnum(1))
+    assert d.mod("20.5") == mnum("6.5")
+    assert d.div(mnum(10**30)) == 10**30 // 7
+    assert mnum.Divisor("-0.5").mod(mnum("1.75")) == mnum("-0.25")
+    assert repr(d) == "Divisor(7)"
+
+
+@pytest.mark.parametrize("zero", [0, "0.000", mnum(0), 0.0])
+def test_zero_divisor(zero):
+    with pytest.raises(ZeroDivisionError):
+        mnum.Divisor(zero)
@@ -0,0 +1,73 @@
+import operator
+
+import pytest
+
+from mnum import mnum
+
+
+INPLACE = [
+    (operator.iadd, operator.add),
+    (operator.isub, operator.sub),
+    (operator.imul, operator.mul),
+    (operator.itruediv, operator.truediv),
+    (operator.ifloordiv, operator.floordiv),
+    (operator.imod, operator.mod),
+]
+
+
+# operands around the machine word and the inline digit storage
+def operands():
+    values = []
+    for digits in (18, 19, 31, 32, 33):
+        n = int("7" * digits)
+        values += [mnum(n), mnum(-n), mnum(str(n) + ".25"), mnum("-0." + "3" * digits)]
+    return values
+
+
+@pytest.mark.parametrize("iop, op", INPLACE)
+def test_inplace_matches_binary(iop, op):
+    for x in operands():
+        for y in operands():
+            expected = op(x, y)
+            z = mnum(str(x))
+            alias = z
+            result = iop(z, y)
+            assert result is alias
+            assert z == expected
+            assert y == mnum(str(y))  # the borrowed operand is untouched
+
+
+@pytest.mark.parametrize("iop, op", INPLACE)
+def test_inplace_aliased(iop, op):
+    for x in operands():
+        expected = op(x, x)
+        z = mnum(str(x))
+        alias = z
+        z = iop(z, z)
+        assert z is alias
+        assert z == expected
+
+
+@pytest.mark.parametrize("other", [3, -2**70, "1.5", 0.25])
+def test_inplace_converted_operands(other):
+    for x in operands():
+        z = mnum(str(x))
+        alias = z
+        z += other
+        z *= other
+        assert z is alias
+        assert z == (x + other) * other
+
+
+def test_idiv():
+    for x in operands():
+        for y in operands():
+            z = mnum(str(x))
+            assert z.idiv(y) is z
+            assert z == x.div(y)
+    z = mnum("12.5")
+    assert z.idiv(z) is z
+    assert z == 1
+    with pytest.raises(ZeroDivisionError):
+        z.idiv(0)
+    assert z == 1
@@ -0,0 +1,29 @@
+import pytest
+
+from mnum import mnum
+
+
+# sizes around the machine word and the 9 digit limb splits
+@pytest.mark.parametrize("bits", [62, 63, 64, 65, 127, 128, 129, 256, 257, 1000, 4096, 50000])
+@pytest.mark.parametrize("sign", [1, -1])
+def test_int_round_trip(bits, sign):
+    n = sign * ((1 << bits) - 12345)
+    m = mnum(n)
+    assert int(m) == n
+    assert int(-m) == -n
+    if bits < 4000:  # str of larger ints is limited by python
+        assert repr(m) == str(n)
+
+
+@pytest.mark.parametrize("digits", [17, 18, 19, 36, 37, 1000])
+def test_powers_of_ten(digits):
+    n = 10 ** digits
+    assert int(mnum(n)) == n
+    assert int(mnum(n - 1)) == n - 1
+    assert int(mnum("1" + "0" * digits)) == n
+
+
+def test_fraction_is_truncated():
+    assert int(mnum("123.99")) == 123
+    assert int(mnum("-123.99")) == -123
+    assert int(mnum("0.5")) == 0
@@ -0,0 +1,58 @@
+#include "test.h"
+
+// digits around the 9 digit limb boundaries pack and unpack unchanged.
+void test_round_trip()
+{
+    for (size_t size = 1; size <= 40; ++size)
+    {
+        const digit_vector x = convert(random_number(size));
+        const limb_vector limbs = to_limbs(x);
+        CHECK(limbs.size() == (size + LIMB_DIGITS - 1) / LIMB_DIGITS);
+        CHECK(from_limbs(limbs) == x);
+    }
+    CHECK(to_limbs(convert("999999999")) == limb_vector(1, 999999999));
+    CHECK(to_limbs(convert("1000000000")) == limb_vector({0, 1}));
+    CHECK(to_limbs(convert("000000000123")) == limb_vector(1, 123));
+    CHECK(to_limbs(convert("0")).empty());
+    CHECK(from_limbs(limb_vector()) == convert("0"));
+    CHECK(from_limbs(limb_vector({5, 0, 0})) == convert("5"));
+}
+
+// products on both sides of the limb boundaries match the reference.
+void test_mul()
+{
+    for (size_t size = 17; size <= 40; ++size)
+    {
+        const digit_vector x = convert(random_number(size));
+        const digit_vector y = convert(random_number(size / 2 + 1));
+        CHECK(to_limbs(mul(x, y)) == ref_mul(to_limbs(x), to_limbs(y)));
+        CHECK(to_limbs(sqr(x)) == ref_mul(to_limbs(x), to_limbs(x)));
+    }
+    CHECK_STR(mnum("999999999999999999999") * mnum("999999999999999999999"),
+              "999999999999999999998000000000000000000001");
+}
+
+// division by a single limb divisor is exact.
+void test_short_division()
+{
+    for (size_t size = 19; size <= 60; size += 7)
+    {
+        const limb_vector x = random_limbs(size / LIMB_DIGITS + 1);
+        for (const limb y : {1U, 7U, 999999999U})
+        {
+            limb rem;
+            const limb_vector quot = ldivmod_small(x, y, rem);
+            CHECK(check_divmod(x, limb_vector(1, y), {quot, rem ? limb_vector(1, rem) : limb_vector()}));
+        }
+    }
+    CHECK_STR(mnum("123456789123456789123456789").div(mnum(7)), "17636684160493827017636684");
+    CHECK_STR(mnum("123456789123456789123456789") % mnum(7), "1");
+}
+
+int main()
+{
+    test_round_trip();
+    test_mul();
+    test_short_division();
+    return test_result("limbs");
+}
@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <vector>
+#include "test.h"
+
+#ifdef __SIZEOF_INT128__
+typedef __int128 wide;
+
+std::string wide_str(const wide value)
+{
+    unsigned __int128 mag = value < 0 ? -static_cast<unsigned __int128>(value)
+                                      : static_cast<unsigned __int128>(value);
+    std::string s;
+    do
+    {
+        s.insert(s.begin(), static_cast<char>('0' + static_cast<int>(mag % 10)));
+        mag /= 10;
+    } while (mag);
+    return value < 0 ? "-" + s : s;
+}
+
+// magnitudes of 17, 18 and 19 digits around 10^18.
+std::vector<wide> machine_operands()
+{
+    const wide e17 = 100000000000000000LL, e18 = 10 * e17;
+    std::vector<wide> values = {1, 7, e17 - 1, e17, e18 - 1, e18, e18 + 1, 10 * e18 - 1};
+    for (const size_t size : {MACHINE_DIGITS - 1, MACHINE_DIGITS, MACHINE_DIGITS + 1})
+    {
+        const std::string digits = random_number(size);
+        wide value = 0;
+        for (const char c : digits)
+            value = value * 10 + (c - '0');
+        values.push_back(value);
+    }
+    const size_t count = values.size();
+    for (size_t i = 0; i < count; ++i)
+        values.push_back(-values[i]);
+    return values;
+}
+
+// floor quotient and remainder, the remainder takes the divisor sign.
+void floor_divmod(const wide x, const wide y, wide &quot, wide &rem)
+{
+    quot = x / y;
+    rem = x % y;
+    if (rem != 0 && ((rem < 0) != (y < 0)))
+    {
+        --quot;
+        rem += y;
+    }
+}
+
+void test_machine_operands()
+{
+    const std::vector<wide> values = machine_operands();
+    for (const wide a : values)
+        for (const wide b : values)
+        {
+            const mnum x(wide_str(a)), y(wide_str(b));
+            CHECK_STR(x + y, wide_str(a + b));
+            CHECK_STR(x - y, wide_str(a - b));
+            CHECK_STR(x * y, wide_str(a * b));
+            wide quot, rem;
+            floor_divmod(a, b, quot, rem);
+            CHECK_STR(x.floor_div(y), wide_str(quot));
+            CHECK_STR(x % y, wide_str(rem));
+            CHECK(x.div(y) == mnum(wide_str(a / b))); // a zero quotient may print "-0"
+
+            mnum z(x);
+            z += y;
+            CHECK_STR(z, wide_str(a + b));
+            z -= y;
+            CHECK_STR(z, wide_str(a));
+            z *= y;
+            CHECK_STR(z, wide_str(a * b));
+        }
+}
+
+void test_machine_integers()
+{
+    const std::vector<wide> values = machine_operands();
+    std::vector<int_fast64_t> ints = {INT64_MAX, INT64_MIN, INT64_MAX - 1, INT64_MIN + 1};
+    for (const wide value : values)
+        if (value <= INT64_MAX && value >= INT64_MIN)
+            ints.push_back(static_cast<int_fast64_t>(value));
+    for (const wide a : values)
+        for (const int_fast64_t b : ints)
+        {
+            const mnum x(wide_str(a));
+            CHECK_STR(x + b, wide_str(a + b));
+            CHECK_STR(x - b, wide_str(a - b));
+            CHECK_STR(x * b, wide_str(a * b));
+            wide quot, rem;
+            floor_divmod(a, b, quot, rem);
+            CHECK_STR(x.floor_div(b), wide_str(quot));
+            CHECK_STR(x % b, wide_str(rem));
+            CHECK_STR(mnum(b), wide_str(b));
+        }
+}
+
+void test_machine_fallback()
+{
+    // a fraction on either side leaves the machine path
+    const wide e18 = 1000000000000000000LL;
+    for (const wide a : {e18 - 1, e18, e18 + 1})
+    {
+        const mnum x(wide_str(a)), half("0.5");
+        CHECK_STR(x + half, wide_str(a) + ".5");
+        CHECK_STR(half + x, wide_str(a) + ".5");
+        CHECK_STR(x - half, wide_str(a - 1) + ".5");
+        CHECK_STR(x * half, wide_str(a / 2) + (a % 2 ? ".5" : ""));
+        CHECK_STR(-x + half, "-" + wide_str(a - 1) + ".5");
+    }
+    // results leaving the machine range
+    CHECK_STR(mnum("999999999999999999") + mnum("1"), "1000000000000000000");
+    CHECK_STR(mnum("-999999999999999999") - mnum("1"), "-1000000000000000000");
+    CHECK_STR(mnum("999999999999999999") * mnum("999999999999999999"),
+              "999999999999999998000000000000000001");
+    CHECK_STR(mnum("1000000000000000000") - mnum("1"), "999999999999999999");
+    CHECK_STR(mnum("5") - mnum("5"), "0");
+    CHECK_THROWS(mnum("999999999999999999") % mnum("0"), std::domain_error);
+}
+#endif
+
+int main()
+{
+#ifdef __SIZEOF_INT128__
+    test_machine_operands();
+    test_machine_integers();
+    test_machine_fallback();
+#endif
+    return test_result("machine");
+}
@@ -0,0 +1,104 @@
+#include "test.h"
+#include "mexpr.h"
+
+// random signed number with int_size integer and frac_size fraction digits.
+mnum random_mnum(const size_t int_size, const size_t frac_size)
+{
+    std::string s = test_rng()() % 2 ? "-" : "";
+    s += random_number(int_size);
+    if (frac_size)
+        s += "." + random_number(frac_size);
+    return mnum(s);
+}
+
+// exact value rounded once to max_fraction digits.
+mnum round_once(mnum x, const size_t max_fraction)
+{
+    return x.quantize(max_fraction);
+}
+
+void test_fused()
+{
+    // leaves just below, at and just above the karatsuba operand size
+    const size_t digits = KARATSUBA_THRESHOLD * LIMB_DIGITS;
+    for (size_t size = digits - LIMB_DIGITS; size <= digits + LIMB_DIGITS; size += LIMB_DIGITS)
+    {
+        const mnum a = random_mnum(size, 0), b = random_mnum(size, 5);
+        const mnum c = random_mnum(5, size), d = random_mnum(size / 2, size / 2);
+        const mnum e = random_mnum(3, 7);
+        mnum r = lazy(a) * b + lazy(c) * d;
+        CHECK(r == a * b + c * d);
+        r = lazy(a) * b - lazy(c) * d - e;
+        CHECK(r == a * b - c * d - e);
+        r = lazy(a) + b * c;
+        CHECK(r == a + b * c);
+        r = lazy(e) - a;
+        CHECK(r == e - a);
+        // cancelling terms
+        r = lazy(a) * b - lazy(b) * a;
+        CHECK_STR(r, "0");
+    }
+}
+
+void test_squares()
+{
+    for (const size_t size : {MACHINE_DIGITS, INLINE_DIGITS + 1, KARATSUBA_THRESHOLD * LIMB_DIGITS})
+    {
+        const mnum a = random_mnum(size, 4), b(a), c = -a;
+        mnum r = lazy(a) * a;
+        CHECK(r == a * a);
+        r = lazy(a) * b; // equal values take the squaring path as well
+        CHECK(r == a * a);
+        r = lazy(a) * c; // equal magnitudes of opposite sign
+        CHECK(r == a * c);
+        CHECK(r.sign || r == mnum(0));
+        r = lazy(a) * a - lazy(b) * b;
+        CHECK_STR(r, "0");
+    }
+}
+
+void test_rounded_once()
+{
+    context_scope scope;
+    const mnum a("1.25"), b("1.25"), c("0.0625"), d("3");
+    // rounding each product first gives 1.751 for three digits, 1.76 for two
+    for (const size_t mf : {1U, 2U, 3U, 4U, 5U})
+    {
+        getcontext().max_fraction = UNBOUNDED;
+        const mnum exact = a * b + c * d;
+        getcontext().max_fraction = mf;
+        mnum r = lazy(a) * b + lazy(c) * d;
+        CHECK(r.frac <= mf);
+        CHECK(r == round_once(exact, mf));
+    }
+}
+
+void test_rounding_modes()
+{
+    context_scope scope;
+    context &ctx = getcontext();
+    // fraction digits just below, at and just above the bound
+    for (const rounding mode : {ROUND_HALF_EVEN, ROUND_DOWN, ROUND_UP, ROUND_CEILING, ROUND_FLOOR})
+    {
+        ctx.mode = mode;
+        for (size_t size = 19; size <= 21; ++size)
+        {
+            const mnum x = random_mnum(4, size / 2), y = random_mnum(3, size - size / 2);
+            const mnum z = random_mnum(2, size);
+            ctx.max_fraction = UNBOUNDED;
+            const mnum exact = x * y - z;
+            ctx.max_fraction = 20;
+            const mnum r = lazy(x) * y - z;
+            CHECK(r == round_once(exact, 20));
+        }
+    }
+}
+
+int main()
+{
+    test_fused();
+    test_squares();
+    test_rounded_once();
+    test_rounding_modes();
+    return test_result("mexpr");
+}
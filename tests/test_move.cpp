@@ -0,0 +1,92 @@
+#include <vector>
+#include "test.h"
+
+// signed operands with integer and fraction parts around the inline
+// digit capacity and the machine word.
+std::vector<mnum> move_operands()
+{
+    std::vector<mnum> values;
+    for (const size_t size : {MACHINE_DIGITS, MACHINE_DIGITS + 1, INLINE_DIGITS - 1,
+                              INLINE_DIGITS, INLINE_DIGITS + 1})
+    {
+        values.emplace_back(random_number(size));
+        values.emplace_back("-" + random_number(size) + "." + random_number(3));
+        values.emplace_back(random_number(2) + "." + random_number(size));
+    }
+    return values;
+}
+
+void test_rvalue_operators()
+{
+    const std::vector<mnum> values = move_operands();
+    for (const mnum &x : values)
+        for (const mnum &y : values)
+        {
+            mnum t(x);
+            CHECK((mnum(x) + y).str() == (x + y).str());
+            CHECK((mnum(x) - y).str() == (x - y).str());
+            CHECK((mnum(x) * y).str() == (x * y).str());
+            CHECK((mnum(x) % y).str() == (x % y).str());
+            CHECK((std::move(t) + y).str() == (x + y).str());
+            // chains of temporaries
+            CHECK((mnum(x) * y + x - y).str() == (((x * y) + x) - y).str());
+            // aliased operands
+            mnum u(x);
+            CHECK((std::move(u) + u).str() == (x + x).str());
+        }
+    for (const mnum &x : values)
+        for (const int_fast64_t y : {static_cast<int_fast64_t>(-7), static_cast<int_fast64_t>(999999999999999999LL),
+                                     static_cast<int_fast64_t>(INT64_MIN)})
+        {
+            CHECK((mnum(x) + y).str() == (x + y).str());
+            CHECK((mnum(x) - y).str() == (x - y).str());
+            CHECK((mnum(x) * y).str() == (x * y).str());
+            CHECK((mnum(x) % y).str() == (x % y).str());
+        }
+}
+
+void test_rvalue_unary()
+{
+    const std::vector<mnum> values = move_operands();
+    for (const mnum &x : values)
+    {
+        CHECK((-mnum(x)).str() == (-x).str());
+        CHECK((+mnum(x)).str() == (+x).str());
+        CHECK(mnum(x).abs().str() == x.abs().str());
+        CHECK(mnum(x).as_int().str() == x.as_int().str());
+        CHECK(mnum(x).as_float().str() == x.as_float().str());
+
+        // the limb buffer is handed over
+        mnum t(x);
+        const limb *data = t.mag.data();
+        const mnum neg = -std::move(t);
+        CHECK(neg.mag.data() == data);
+    }
+}
+
+void test_moved_from()
+{
+    for (const size_t size : {INLINE_DIGITS - 1, INLINE_DIGITS, INLINE_DIGITS + 1})
+    {
+        const std::string digits = random_number(size);
+        mnum x(digits + "." + digits);
+        mnum y(std::move(x));
+        CHECK_STR(y, digits + "." + digits);
+        // a moved from number can be assigned and used again
+        x = mnum(digits);
+        CHECK_STR(x + mnum(1), (mnum(digits) + mnum(1)).str());
+        mnum z("5");
+        z = std::move(y);
+        CHECK_STR(z, digits + "." + digits);
+        y = z;
+        CHECK(y == z);
+    }
+}
+
+int main()
+{
+    test_rvalue_operators();
+    test_rvalue_unary();
+    test_moved_from();
+    return test_result("move");
+}
@@ -0,0 +1,120 @@
+#include "test.h"
+
+// products of x_size by y_size limbs match the schoolbook reference.
+void check_products(const size_t x_size, const size_t y_size)
+{
+    const limb_vector x = random_limbs(x_size), y = random_limbs(y_size);
+    CHECK(lmul(x, y) == ref_mul(x, y));
+    CHECK(lmul(y, x) == ref_mul(x, y));
+}
+
+// sizes just below, at and just above a threshold.
+void check_threshold(const size_t threshold)
+{
+    for (size_t size = threshold - 1; size <= threshold + 1; ++size)
+    {
+        check_products(size, size);
+        check_products(size + 5, size);
+        check_products(2 * size + 1, size);
+    }
+}
+
+// basecase product and square written into a fresh buffer.
+limb_vector basecase(const limb_vector &x, const limb_vector &y)
+{
+    limb_vector res(x.size() + y.size());
+    if (&x == &y)
+        sqr_basecase(res.data(), x.data(), x.size());
+    else
+        mul_basecase(res.data(), x.data(), x.size(), y.data(), y.size());
+    trim_limbs(res);
+    return res;
+}
+
+void test_comba()
+{
+    // columns just below, at and just above one and two carry blocks
+    for (const size_t block : {COMBA_BLOCK, 2 * COMBA_BLOCK})
+        for (size_t size = block - 1; size <= block + 1; ++size)
+        {
+            const limb_vector x = random_limbs(size), y = random_limbs(size);
+            const limb_vector z = random_limbs(size + 3);
+            CHECK(basecase(x, y) == ref_mul(x, y));
+            CHECK(basecase(z, x) == ref_mul(z, x));
+            CHECK(basecase(x, z) == ref_mul(z, x));
+            CHECK(basecase(x, x) == ref_mul(x, x));
+            // all limbs at their maximum fill each block to its headroom
+            const limb_vector m(size, LIMB_BASE - 1);
+            CHECK(basecase(m, m) == ref_mul(m, m));
+            CHECK(basecase(m, z) == ref_mul(m, z));
+        }
+    // single limb operands
+    const limb_vector one(1, LIMB_BASE - 1), x(COMBA_BLOCK + 1, LIMB_BASE - 1);
+    CHECK(basecase(one, x) == ref_mul(one, x));
+    CHECK(basecase(one, one) == ref_mul(one, one));
+}
+
+void test_karatsuba()
+{
+    check_threshold(KARATSUBA_THRESHOLD);
+    // all limbs at their maximum carry through every addition
+    const limb_vector x(KARATSUBA_THRESHOLD + 3, LIMB_BASE - 1);
+    CHECK(lmul(x, x) == ref_mul(x, x));
+    // operands packed from digits take the same path
+    const mnum a(random_number(KARATSUBA_THRESHOLD * LIMB_DIGITS));
+    const mnum b(random_number(KARATSUBA_THRESHOLD * LIMB_DIGITS + 1));
+    CHECK((a * b).mag == ref_mul(a.mag, b.mag));
+}
+
+void test_toom3()
+{
+    check_threshold(TOOM3_THRESHOLD);
+    // uneven thirds of the operands
+    check_products(TOOM3_THRESHOLD + 2, TOOM3_THRESHOLD + 1);
+    const limb_vector x(TOOM3_THRESHOLD + 1, LIMB_BASE - 1);
+    CHECK(lmul(x, x) == ref_mul(x, x));
+}
+
+void test_ntt()
+{
+    check_threshold(NTT_THRESHOLD);
+    // largest limbs give the largest convolution sums to reconstruct
+    const limb_vector x(NTT_THRESHOLD + 1, LIMB_BASE - 1);
+    CHECK(lmul(x, x) == ref_mul(x, x));
+    CHECK(lsqr(x) == ref_mul(x, x));
+}
+
+void test_squaring()
+{
+    for (const size_t threshold : {KARATSUBA_THRESHOLD, TOOM3_THRESHOLD, NTT_THRESHOLD})
+        for (size_t size = threshold - 1; size <= threshold + 1; ++size)
+        {
+            const limb_vector x = random_limbs(size);
+            CHECK(lsqr(x) == ref_mul(x, x));
+        }
+    for (size_t size = 1; size < 8; ++size)
+    {
+        const limb_vector x = random_limbs(size);
+        CHECK(lsqr(x) == ref_mul(x, x));
+    }
+    // digit squares on both sides of the machine word path
+    for (size_t size = MACHINE_DIGITS - 1; size <= MACHINE_DIGITS + 2; ++size)
+    {
+        const digit_vector x = convert(random_number(size)), y(x);
+        CHECK(sqr(x) == mul(x, y));
+        CHECK(to_limbs(sqr(x)) == ref_mul(to_limbs(x), to_limbs(x)));
+    }
+    // equal operands of a float product take the squaring path
+    const mnum a("123456789.987654321"), b("123456789.987654321");
+    CHECK_STR(a * b, "15241578994055784.200731595789971041");
+}
+
+int main()
+{
+    test_comba();
+    test_karatsuba();
+    test_toom3();
+    test_ntt();
+    test_squaring();
+    return test_result("mul");
+}
@@ -0,0 +1,116 @@
+#include "test.h"
+
+// powers by squaring match repeated multiplication.
+void test_binary_power()
+{
+    const limb_vector base = random_limbs(3);
+    limb_vector expected(1, 1);
+    for (limb exp = 0; exp <= 40; ++exp)
+    {
+        CHECK(lpow(base, exp ? limb_vector(1, exp) : limb_vector()) == expected);
+        expected = ref_mul(expected, base);
+    }
+    // exponents past one 29 bit chunk of lbits
+    const limb_vector big_exp({(1U << 29) + 1});
+    CHECK(lpow(limb_vector(1, 1), big_exp) == limb_vector(1, 1));
+    CHECK(lbits(big_exp).size() == 30);
+
+    CHECK_STR(mnum(2).pow(mnum(100)), "1267650600228229401496703205376");
+    CHECK_STR(mnum(-3).pow(mnum(5)), "-243");
+    CHECK_STR(mnum(7).pow(mnum(0)), "1");
+    CHECK_STR(mnum("1.5").pow(mnum(3)), "3.375");
+    CHECK_STR(mnum(2).pow(mnum(-3)), "0.125");
+    CHECK_THROWS(mnum(2).pow(mnum("0.5")), std::domain_error);
+}
+
+// square and multiply reduced by long division, the reference for lpowmod.
+limb_vector ref_powmod(const limb_vector &base, const limb_vector &exp, const limb_vector &mod)
+{
+    const std::vector<bool> bits = lbits(exp);
+    limb_vector result = ldivmod(limb_vector(1, 1), mod).second;
+    for (size_t i = bits.size(); i-- > 0;)
+    {
+        result = ldivmod(ref_mul(result, result), mod).second;
+        if (bits[i])
+            result = ldivmod(ref_mul(result, base), mod).second;
+    }
+    return result;
+}
+
+void test_powmod()
+{
+    // exponent lengths select window widths 1 to 6
+    const size_t exp_sizes[] = {1, 2, 3, 9, 27, 80};
+    for (size_t mod_size = 1; mod_size <= BARRETT_THRESHOLD + 1; ++mod_size)
+        for (const size_t exp_size : exp_sizes)
+        {
+            const limb_vector base = random_limbs(mod_size + 1), mod = random_limbs(mod_size);
+            const limb_vector exp = random_limbs(exp_size);
+            CHECK(lpowmod(base, exp, mod) == ref_powmod(base, exp, mod));
+        }
+    CHECK(lpowmod(random_limbs(3), random_limbs(2), limb_vector(1, 1)).empty());
+    CHECK(lpowmod(random_limbs(3), limb_vector(), random_limbs(2)) == limb_vector(1, 1));
+
+    // signs and inverses follow python's pow(base, exp, mod)
+    CHECK_STR(mnum(3).pow(mnum(-1), mnum(7)), "5");
+    CHECK_STR(mnum(-2).pow(mnum(3), mnum(5)), "2");
+    CHECK_STR(mnum(2).pow(mnum(10), mnum(-7)), "-5");
+    CHECK_STR(mnum("12345678901234567890").pow(mnum("98765432109876543210"), mnum(1000000007)),
+              "577648646");
+    CHECK_THROWS(mnum(2).pow(mnum(3), mnum(0)), std::invalid_argument);
+    CHECK_THROWS(mnum(2).pow(mnum(-1), mnum(4)), std::invalid_argument);
+    CHECK_THROWS(mnum("2.5").pow(mnum(2), mnum(3)), std::domain_error);
+}
+
+// root * root <= x < (root + 1) * (root + 1) and the remainder matches.
+bool check_sqrtrem(const limb_vector &x)
+{
+    const std::pair<limb_vector, limb_vector> sr = lsqrtrem(x);
+    limb_vector back = ref_mul(sr.first, sr.first);
+    liadd(back, sr.second);
+    trim_limbs(back);
+    limb_vector twice = sr.first;
+    lmul_small(twice, 2);
+    return lcmp(back, x) == 0 && lcmp(sr.second, twice) <= 0;
+}
+
+void test_roots()
+{
+    // up to four limbs is the newton base case, above is karatsuba square root
+    for (size_t size = 1; size <= 40; ++size)
+    {
+        const limb_vector x = random_limbs(size);
+        CHECK(check_sqrtrem(x));
+        CHECK(check_sqrtrem(limb_vector(size, LIMB_BASE - 1)));
+        const limb_vector root = random_limbs((size + 1) / 2);
+        limb_vector square = ref_mul(root, root);
+        CHECK(lsqrtrem(square).first == root && lsqrtrem(square).second.empty());
+        lisub(square, limb_vector(1, 1));
+        CHECK(check_sqrtrem(square));
+    }
+    CHECK(check_sqrtrem(random_limbs(2 * BZ_THRESHOLD + 7)));
+    for (const limb n : {3U, 5U, 7U})
+    {
+        const limb_vector x = random_limbs(20), root = lroot(x, n);
+        limb_vector next = root;
+        liadd(next, limb_vector(1, 1));
+        const limb_vector exp(1, n);
+        CHECK(lcmp(lpow(root, exp), x) <= 0 && lcmp(lpow(next, exp), x) > 0);
+    }
+
+    CHECK_STR(mnum("12345678901234567890").isqrt(), "3513641828");
+    CHECK_STR(mnum(2).sqrt(30), "1.41421356237309504880168872421");
+    CHECK_STR(mnum("0.0001").sqrt(), "0.01");
+    CHECK_STR(mnum(-27).nth_root(3), "-3");
+    CHECK_STR(mnum(10).nth_root(5, 10), "1.5848931925");
+    CHECK_THROWS(mnum(-4).sqrt(), std::domain_error);
+    CHECK_THROWS(mnum(4).nth_root(0), std::domain_error);
+}
+
+int main()
+{
+    test_binary_power();
+    test_powmod();
+    test_roots();
+    return test_result("pow");
+}
@@ -0,0 +1,69 @@
+import pytest
+
+from mnum import mnum
+
+
+def test_operand_types():
+    x = mnum("2.5")
+    assert x + 1 == mnum("3.5")
+    assert x + 2**80 == mnum("1208925819614629174706178.5")
+    assert x + 0.5 == mnum(3)
+    assert x + "1.5" == mnum(4)
+    assert "1.5" + x == mnum(4)
+    assert 1 - x == mnum("-1.5")
+    assert x * mnum(2) == mnum(5)
+
+
+def test_small_int_fast_path():
+    x = mnum(10**17)
+    assert x + 1 == mnum(10**17 + 1)
+    assert x * 10 == mnum(10**18)
+    assert x * 100 == mnum(10**19)
+    assert mnum(-7) // 2 == mnum(-4)
+    assert mnum(-7) % 2 == mnum(1)
+
+
+def test_inplace_keeps_identity():
+    x = mnum(5)
+    y = x
+    x += "0.5"
+    x *= 2
+    assert x is y
+    assert y == mnum(11)
+
+
+def test_comparisons():
+    x = mnum("-1.5")
+    assert x < -1 and x <= "-1.5" and x > -2.0 and x >= mnum("-1.5")
+    assert x == "-1.5" and x != 1
+    assert (x == object()) is False
+    assert (x != object()) is True
+
+
+@pytest.mark.parametrize("op, error", [
+    (lambda: mnum(1) / 0, ZeroDivisionError),
+    (lambda: mnum(1) // mnum(0), ZeroDivisionError),
+    (lambda: mnum(1) % 0, ZeroDivisionError),
+    (lambda: mnum(1) + float("inf"), OverflowError),
+    (lambda: mnum(1) - float("-inf"), OverflowError),
+    (lambda: mnum(1) * float("nan"), ValueError),
+    (lambda: mnum(1) + "1.2.3", ValueError),
+    (lambda: "abc" - mnum(1), ValueError),
+    (lambda: mnum(1) + object(), TypeError),
+    (lambda: [1] * mnum(1), TypeError),
+    (lambda: mnum(1) < object(), TypeError),
+])
+def test_exception_types(op, error):
+    with pytest.raises(error):
+        op()
+
+
+def test_inplace_exception_types():
+    x = mnum(1)
+    with pytest.raises(ZeroDivisionError):
+        x /= 0
+    with pytest.raises(OverflowError):
+        x += float("inf")
+    with pytest.raises(TypeError):
+        x -= None
+    assert x == 1
@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <vector>
+#include "test.h"
+
+// machine operands below MACHINE_LIMIT, each power of ten and its predecessor.
+std::vector<uint64_t> small_operands()
+{
+    std::vector<uint64_t> values = {1, 2, 7};
+    for (uint64_t tens = 10; tens < MACHINE_LIMIT; tens *= 10)
+    {
+        values.push_back(tens - 1);
+        values.push_back(tens);
+        values.push_back(tens + 1);
+    }
+    values.push_back(MACHINE_LIMIT - 1);
+    return values;
+}
+
+// digit sizes around the machine word and the chunk of y.
+std::vector<size_t> digit_sizes(const uint64_t y)
+{
+    const size_t chunk = small_chunk(y);
+    return {1, MACHINE_DIGITS - 1, MACHINE_DIGITS, MACHINE_DIGITS + 1,
+            std::max<size_t>(chunk - 1, 1), chunk, chunk + 1,
+            2 * chunk - 1, 2 * chunk, 2 * chunk + 1, 5 * chunk + 3};
+}
+
+// random digits and all nines of the given size.
+std::vector<digit_vector> digit_operands(const size_t size)
+{
+    return {convert(random_number(size)), digit_vector(size, 9)};
+}
+
+void test_small_arithmetic()
+{
+    for (const uint64_t y : small_operands())
+    {
+        const limb_vector yl = to_limbs(convert(y));
+        for (const size_t size : digit_sizes(y))
+            for (const digit_vector &x : digit_operands(size))
+            {
+                const limb_vector xl = to_limbs(x);
+                digit_vector z(x);
+                imul_small(z, y);
+                CHECK(to_limbs(z) == ref_mul(xl, yl));
+
+                z = x;
+                const uint64_t rem = divmod_small(z, y);
+                const std::pair<limb_vector, limb_vector> div = ldivmod(xl, yl);
+                CHECK(to_limbs(z) == div.first);
+                CHECK(to_limbs(convert(rem)) == div.second);
+                CHECK(mod_small(x, y) == rem);
+
+                z = x;
+                iadd_small(z, y);
+                limb_vector sum(xl);
+                liadd(sum, yl);
+                CHECK(to_limbs(z) == sum);
+                if (lcmp(xl, yl) >= 0)
+                {
+                    z = x;
+                    isub_small(z, y);
+                    limb_vector diff(xl);
+                    lisub(diff, yl);
+                    CHECK(to_limbs(z) == diff);
+                    CHECK(z.size() == 1 || z[0] != 0);
+                }
+            }
+    }
+}
+
+void test_small_fraction()
+{
+    // fraction carries cross into the integer part
+    for (const uint64_t y : {static_cast<uint64_t>(9), MACHINE_LIMIT / 10, MACHINE_LIMIT - 1})
+        for (const size_t size : digit_sizes(y))
+        {
+            const std::string digits = random_number(size);
+            const mnum x(digits + "." + digits), yd(static_cast<int_fast64_t>(y));
+            limb_vector z(x.mag);
+            size_t fz = x.frac;
+            imul_small(z, fz, y);
+            CHECK(mnum(z, fz, false) == x * yd);
+        }
+}
+
+void test_cmp_small()
+{
+    std::vector<uint64_t> values = small_operands();
+    values.push_back(UINT64_MAX);
+    values.push_back(UINT64_MAX - 1);
+    values.push_back(UINT64_MAX / 10);
+    values.push_back(0);
+    for (const uint64_t y : values)
+    {
+        const limb_vector yl = to_limbs(convert(y));
+        // 19, 20 and 21 digits straddle the width of a uint64_t
+        for (const size_t size : {1U, 18U, 19U, 20U, 21U})
+        {
+            std::vector<digit_vector> xs = digit_operands(size);
+            if (convert(y).size() == size)
+            {
+                xs.push_back(convert(y));
+                digit_vector z = convert(y);
+                z.back() = z.back() == 9 ? 8 : z.back() + 1;
+                xs.push_back(z);
+            }
+            for (const digit_vector &x : xs)
+                CHECK(cmp_small(x, y) == lcmp(to_limbs(x), yl));
+        }
+    }
+}
+
+int main()
+{
+    test_small_arithmetic();
+    test_small_fraction();
+    test_cmp_small();
+    return test_result("small");
+}
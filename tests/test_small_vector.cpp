@@ -0,0 +1,146 @@
+#include <vector>
+#include "test.h"
+
+typedef std::vector<udigit> model;
+
+// same elements as the std::vector model.
+bool same(const digit_vector &x, const model &y)
+{
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+// elements are stored inside the object.
+bool is_inline(const digit_vector &x)
+{
+    const char *obj = reinterpret_cast<const char *>(&x);
+    const char *data = reinterpret_cast<const char *>(x.data());
+    return data >= obj && data < obj + sizeof(x);
+}
+
+model random_digits(const size_t size)
+{
+    model x(size);
+    for (udigit &d : x)
+        d = static_cast<udigit>(test_rng()() % 10);
+    return x;
+}
+
+void test_storage()
+{
+    for (size_t size = INLINE_DIGITS - 1; size <= INLINE_DIGITS + 1; ++size)
+    {
+        const model m = random_digits(size);
+        digit_vector x(m.begin(), m.end());
+        CHECK(same(x, m));
+        CHECK(is_inline(x) == (size <= INLINE_DIGITS));
+
+        // copies keep their own storage
+        digit_vector copy(x);
+        CHECK(same(copy, m));
+        CHECK(copy.data() != x.data());
+        copy[0] = static_cast<udigit>((m[0] + 1) % 10);
+        CHECK(same(x, m));
+
+        // moves steal a heap buffer and copy an inline one
+        const udigit *data = x.data();
+        digit_vector moved(std::move(x));
+        CHECK(same(moved, m));
+        CHECK((moved.data() == data) == (size > INLINE_DIGITS));
+        CHECK(x.empty() && is_inline(x));
+        x = std::move(moved);
+        CHECK(same(x, m));
+        CHECK(moved.empty());
+
+        // assignment between inline and heap vectors
+        digit_vector small(3, 7), large(2 * INLINE_DIGITS, 1);
+        small = x;
+        large = x;
+        CHECK(same(small, m) && same(large, m));
+        small.swap(large);
+        CHECK(same(small, m) && same(large, m));
+    }
+}
+
+void test_growth()
+{
+    for (size_t size = INLINE_DIGITS - 1; size <= INLINE_DIGITS + 1; ++size)
+    {
+        model m;
+        digit_vector x;
+        for (size_t i = 0; i < size; ++i)
+        {
+            m.push_back(static_cast<udigit>(i % 10));
+            x.push_back(static_cast<udigit>(i % 10));
+        }
+        CHECK(same(x, m));
+        CHECK(is_inline(x) == (size <= INLINE_DIGITS));
+
+        // resizing across the inline capacity keeps the prefix
+        x.resize(size + 2, 9);
+        m.resize(size + 2, 9);
+        CHECK(same(x, m));
+        x.resize(size - 2);
+        m.resize(size - 2);
+        CHECK(same(x, m));
+
+        // assigning from its own elements
+        x.assign(x.begin() + 1, x.end());
+        m.assign(m.begin() + 1, m.end());
+        CHECK(same(x, m));
+        x.assign(size, 4);
+        m.assign(size, 4);
+        CHECK(same(x, m));
+    }
+}
+
+void test_modifiers()
+{
+    for (size_t size = INLINE_DIGITS - 2; size <= INLINE_DIGITS + 1; ++size)
+    {
+        model m = random_digits(size);
+        digit_vector x(m.begin(), m.end());
+
+        // inserts that cross the inline capacity
+        x.insert(x.begin(), 5);
+        m.insert(m.begin(), 5);
+        CHECK(same(x, m));
+        x.insert(x.begin() + 3, 2U, 8);
+        m.insert(m.begin() + 3, 2U, 8);
+        CHECK(same(x, m));
+        x.insert(x.end(), x.begin(), x.begin() + 4); // source aliases x
+        m.insert(m.end(), m.begin(), m.begin() + 4);
+        CHECK(same(x, m));
+
+        // erase from the front, middle and back
+        x.erase(x.begin());
+        m.erase(m.begin());
+        CHECK(same(x, m));
+        x.erase(x.begin() + 2, x.begin() + 5);
+        m.erase(m.begin() + 2, m.begin() + 5);
+        CHECK(same(x, m));
+        x.erase(x.end() - 1, x.end());
+        m.erase(m.end() - 1, m.end());
+        CHECK(same(x, m));
+        x.pop_back();
+        m.pop_back();
+        CHECK(same(x, m));
+    }
+    // digit strings on both sides of the inline capacity
+    for (size_t size = INLINE_DIGITS - 1; size <= INLINE_DIGITS + 1; ++size)
+    {
+        const std::string digits = random_number(size);
+        mnum x(digits);
+        CHECK_STR(x, digits);
+        x.insert(0, 1);
+        CHECK_STR(x, "1" + digits);
+        CHECK_STR(mnum(digits + "." + digits), digits + "." + digits);
+    }
+}
+
+int main()
+{
+    test_storage();
+    test_growth();
+    test_modifiers();
+    return test_result("small_vector");
+}